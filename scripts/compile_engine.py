@@ -107,6 +107,7 @@ def main():
     parser.add_argument("--nn-input-size", type=int, default=None)
     parser.add_argument("--batch",        type=int, default=None)
     parser.add_argument("--precision",    type=str, default=None, choices=["fp16", "fp32"])
+    parser.add_argument("--input-layout", type=str, default=None, choices=["dense", "packed"])
 
     args = parser.parse_args()
 
@@ -129,11 +130,19 @@ def main():
         print("[Error] Provide --plan or --config (with a 'name' field).")
         sys.exit(1)
 
+    # Must match the layout the ONNX file was exported with (backend.inputLayout).
+    if args.input_layout:
+        input_layout = args.input_layout
+    elif "backend" in config:
+        input_layout = config["backend"].get("inputLayout", "dense")
+    else:
+        input_layout = "dense"
+
     if args.nn_input_size:
         nn_input_size = args.nn_input_size
     elif game_name:
         meta = load_meta(game_name)
-        nn_input_size = meta["nnInputSize"]
+        nn_input_size = meta["packedInputSize"] if input_layout == "packed" else meta["nnInputSize"]
     else:
         print("[Error] Provide --nn-input-size or --config with a valid game name.")
         sys.exit(1)
@@ -1,10 +1,33 @@
 import os
 import json
-import glob
 import torch
 import numpy as np
 from torch.utils.data import Dataset
 
+def read_file_meta(bin_path: str) -> dict:
+    """
+    Reads the layout sidecar the C++ side writes next to every dataset file
+    (DatasetLayout in ReplayBuffer.hpp). Files without one predate it and hold
+    dense samples whose stride can no longer be derived: they are refused.
+    """
+    meta_path = bin_path + ".meta.json"
+    if not os.path.exists(meta_path):
+        raise ValueError(
+            f"[Dataset] {os.path.basename(bin_path)} has no layout sidecar ({os.path.basename(meta_path)}); "
+            f"it was written by an older build. Move it out of the data folder.")
+    with open(meta_path, "r") as f:
+        return json.load(f)
+
+
+def check_uniform_layout(datasets, expected_layout: str):
+    """Refuses a window mixing sample layouts, or one the model was not built for."""
+    layouts = {d.layout for d in datasets}
+    if layouts != {expected_layout}:
+        files = ", ".join(f"{os.path.basename(d.bin_path)}={d.layout}" for d in datasets if d.layout != expected_layout)
+        raise ValueError(
+            f"[Dataset] Mixed or unexpected input layouts (expected '{expected_layout}'): {files}")
+
+
 class OneMindArmyDataset(Dataset):
     """
     Zero-Copy Binary Dataset Loader.
@@ -24,28 +47,32 @@ class OneMindArmyDataset(Dataset):
 
         # ------------------------------------------------------------------
         # 1. Metadata Resolution
-        # Identifies the C++ layout dimensions required to unpack the binary.
+        # Game geometry comes from the game-wide meta; the sample layout comes
+        # from the file's own sidecar (iteration_XXXX.bin.meta.json), since
+        # files of different layouts may share the folder after an upgrade.
         # ------------------------------------------------------------------
         dir_name   = os.path.dirname(os.path.abspath(bin_path))
-        meta_files = sorted(glob.glob(os.path.join(dir_name, "*.meta.json")))
-
-        if not meta_files:
-            raise FileNotFoundError(f"[Dataset] No *.meta.json found in {dir_name}.")
+        game_name  = os.path.basename(dir_name)
+        meta_path  = os.path.join(dir_name, f"{game_name}_training_data.bin.meta.json")
 
-        if len(meta_files) == 1:
-            meta_path = meta_files[0]
-        else:
-            game_name = os.path.basename(dir_name)
-            canonical = os.path.join(dir_name, f"{game_name}_training_data.bin.meta.json")
-            meta_path = canonical if canonical in meta_files else meta_files[0]
+        if not os.path.exists(meta_path):
+            raise FileNotFoundError(f"[Dataset] Game meta not found: {meta_path}")
 
         with open(meta_path, "r") as f:
             self.meta = json.load(f)
 
+        self.file_meta = read_file_meta(bin_path)
+
         self.action_space    = self.meta["actionSpace"]
         self.num_players     = self.meta["numPlayers"]
         self.nn_input_size   = self.meta["nnInputSize"]
-        self.cpp_struct_size = self.meta.get("sizeofTrainingSample", None)
+        self.cpp_struct_size = self.file_meta["sizeofTrainingSample"]
+
+        # Packed samples (StateEncoder::encodePacked) are returned as stored;
+        # OneMindArmyNet.forward(x, packed=True) unpacks them on the device.
+        self.layout          = self.file_meta["inputLayout"]
+        self.packed          = self.layout == "packed"
+        self.input_size      = self.file_meta["inputSize"]
 
         # Calculates minimum byte size required to unpack the bit-packed boolean mask.
         self.mask_bytes_size = (self.action_space + 7) // 8
@@ -58,14 +85,14 @@ class OneMindArmyDataset(Dataset):
         wdl_size = self.num_players * 3  
 
         data_fields = [
-            ("nn_input",   np.float32, (self.nn_input_size,)),
+            ("nn_input",   np.float32, (self.input_size,)),
             ("policy",     np.float32, (self.action_space,)),
             ("wdl_target", np.float32, (wdl_size,)),          
             ("legal_mask", np.uint8,   (self.mask_bytes_size,)),
         ]
 
         data_size_bytes = (
-            (self.nn_input_size + self.action_space + wdl_size) * 4
+            (self.input_size + self.action_space + wdl_size) * 4
             + self.mask_bytes_size
         )
 
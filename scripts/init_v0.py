@@ -7,7 +7,7 @@ import subprocess
 import torch
 from pathlib import Path
 
-from train import OneMindArmyNet, export_to_onnx, compile_tensorrt_engine
+from train import OneMindArmyNet, export_to_onnx, export_cpu_weights, compile_tensorrt_engine
 
 def bootstrap_v0(config_path: str):
     """
@@ -22,8 +22,9 @@ def bootstrap_v0(config_path: str):
       2. PyTorch constructs a randomized architecture matching those bounds.
       3. The initialized weights are saved (`latest_checkpoint.pt`) to anchor 
          the training loop to this exact starting state.
-      4. The model is compiled into TensorRT (`best_model.plan`) so C++ can 
-         begin the iteration 0 rollout.
+      4. The model is compiled into TensorRT (`best_model.plan`) and dumped
+         for the CPU backend (`best_model.weights`) so C++ can begin the
+         iteration 0 rollout.
     """
     with open(config_path, "r") as f:
         config = yaml.safe_load(f)
@@ -31,6 +32,8 @@ def bootstrap_v0(config_path: str):
     game_name     = config["name"]
     trt_opt_batch = config["backend"].get("inferenceBatchSize", 256)
     trt_precision = config["backend"].get("precision", "fp16").lower()
+    use_tensorrt  = config["backend"].get("inferenceBackend", "tensorrt") == "tensorrt"
+    input_layout  = config["backend"].get("inputLayout", "dense")
 
     print("=" * 60)
     print(f"  Bootstrapping v0 random model  —  game: [{game_name}]")
@@ -94,6 +97,7 @@ def bootstrap_v0(config_path: str):
     checkpoint_path = model_dir / "latest_checkpoint.pt"
     onnx_path       = model_dir / "latest_model.onnx"
     best_plan_path  = model_dir / "best_model.plan"
+    best_cpu_path   = model_dir / "best_model.weights"
 
     print("\n[Init] Building PyTorch Transformer with random weights ...")
     model = OneMindArmyNet(config, meta)
@@ -122,18 +126,23 @@ def bootstrap_v0(config_path: str):
     # ------------------------------------------------------------------
     # 5. TensorRT Compilation
     # ------------------------------------------------------------------
-    export_to_onnx(model, meta, str(onnx_path))
-    compile_tensorrt_engine(
-        str(onnx_path),
-        str(best_plan_path),
-        meta,
-        trt_opt_batch,
-        precision=trt_precision,
-    )
+    export_to_onnx(model, meta, str(onnx_path), input_layout)
+    export_cpu_weights(model, meta, str(best_cpu_path))
+    if use_tensorrt:
+        compile_tensorrt_engine(
+            str(onnx_path),
+            str(best_plan_path),
+            meta,
+            trt_opt_batch,
+            precision=trt_precision,
+            layout=input_layout,
+        )
 
     print(f"\n[Init] v0 bootstrap complete.")
     print(f"  Checkpoint : {checkpoint_path}")
-    print(f"  TRT engine : {best_plan_path}")
+    if use_tensorrt:
+        print(f"  TRT engine : {best_plan_path}")
+    print(f"  CPU weights: {best_cpu_path}")
     print("  You can now start the Orchestrator.")
 
 if __name__ == "__main__":
@@ -3,6 +3,7 @@ import sys
 import json
 import time
 import shutil
+import signal
 import logging
 import platform
 import subprocess
@@ -168,22 +169,6 @@ class OneMindArmyPipeline:
         max_samples = training_cfg.get("slidingWindowSamples", 7_500_000)
         max_files = training_cfg.get("maxWindowIterations", 10)
 
-        meta_files = sorted(self.data_dir.glob("*.meta.json"))
-        if not meta_files:
-            logger.warning("[SlidingWindow] meta.json not found — skipping window enforcement.")
-            return
-
-        canonical_meta = self.data_dir / f"{self.game_name}_training_data.bin.meta.json"
-        meta_path = canonical_meta if canonical_meta.exists() else meta_files[0]
-
-        with open(meta_path, "r", encoding="utf-8") as f:
-            meta = json.load(f)
-
-        struct_size = meta.get("sizeofTrainingSample")
-        if not struct_size:
-            logger.warning("[SlidingWindow] 'sizeofTrainingSample' missing in meta.json — skipping.")
-            return
-
         bin_files = sorted(
             self.data_dir.glob("iteration_*.bin"), 
             key=lambda x: int(x.stem.split('_')[1])
@@ -191,7 +176,25 @@ class OneMindArmyPipeline:
         if not bin_files:
             return
 
-        file_stats = [(f, f.stat().st_size // struct_size) for f in bin_files]
+        # Sample size and layout come from each file's own sidecar
+        # (iteration_XXXX.bin.meta.json, see DatasetLayout in ReplayBuffer.hpp).
+        # Files without one, or a window mixing layouts, are refused: counting
+        # them with the wrong stride would silently corrupt the window.
+        file_metas = []
+        for f in bin_files:
+            sidecar = f.with_name(f.name + ".meta.json")
+            if not sidecar.exists():
+                raise RuntimeError(
+                    f"[SlidingWindow] {f.name} has no layout sidecar (written by an older build). "
+                    f"Move it out of {self.data_dir} before resuming.")
+            with open(sidecar, "r", encoding="utf-8") as fm:
+                file_metas.append(json.load(fm))
+
+        layouts = {(m["inputLayout"], m["sizeofTrainingSample"]) for m in file_metas}
+        if len(layouts) > 1:
+            raise RuntimeError(f"[SlidingWindow] Mixed sample layouts in {self.data_dir}: {sorted(layouts)}")
+
+        file_stats = [(f, f.stat().st_size // m["sizeofTrainingSample"]) for f, m in zip(bin_files, file_metas)]
         total_samples = sum(s for _, s in file_stats)
 
         logger.info(
@@ -205,6 +208,8 @@ class OneMindArmyPipeline:
             oldest_file, oldest_count = file_stats.pop(0)
             try:
                 os.remove(oldest_file)
+                oldest_file.with_name(oldest_file.name + ".ready").unlink(missing_ok=True)
+                oldest_file.with_name(oldest_file.name + ".meta.json").unlink(missing_ok=True)
                 total_samples -= oldest_count
                 deleted += 1
                 logger.info(
@@ -246,6 +251,10 @@ class OneMindArmyPipeline:
         cmd = [sys.executable, "scripts/init_v0.py", "--config", str(self.config_path)]
         self.run_command(cmd, "Bootstrap v0 (random model initialization)")
 
+    def phase_export_meta(self):
+        cmd = [str(self.cpp_engine_path), str(self.config_path), "--mode", "export-meta"]
+        self.run_command(cmd, "Export game metadata")
+
     def phase_self_play(self, model_name: str):
         cmd = [
             str(self.cpp_engine_path),
@@ -259,6 +268,41 @@ class OneMindArmyPipeline:
         cmd = [sys.executable, "scripts/train.py", "--config", str(self.config_path)]
         self.run_command(cmd, "Neural Network Training + TRT Compilation")
 
+    def publish_model(self, latest_model_path: Path, best_model_path: Path):
+        """Copy then rename, so a running self-play never sees a half-written model."""
+        tmp_path = best_model_path.with_name(best_model_path.name + ".tmp")
+        shutil.copy(latest_model_path, tmp_path)
+        os.replace(tmp_path, best_model_path)
+
+    # ------------------------------------------------------------------
+    # Model paths
+    # ------------------------------------------------------------------
+
+    def prepare_models(self):
+        """Returns (best_model_name, best_model_path, latest_model_path), bootstrapping v0 if needed."""
+        # Only the TensorRT backend consumes a .plan; the others read (or ignore) the .weights dump.
+        backend = self.config.get("backend", {}).get("inferenceBackend", "tensorrt")
+        model_ext = ".plan" if backend == "tensorrt" else ".weights"
+
+        best_model_name = f"best_model{model_ext}"
+        best_model_path  = self.models_dir / best_model_name
+        latest_model_path = self.models_dir / f"latest_model{model_ext}"
+
+        # With a heuristic warm-up the first self-play runs need no network:
+        # only the game metadata is required before train.py builds the model.
+        heuristic_iters = self.config.get("backend", {}).get("heuristicIterations", 0)
+
+        if not best_model_path.exists():
+            if heuristic_iters > 0 and self.get_start_iteration() <= heuristic_iters:
+                logger.warning(f"No '{best_model_name}' found — heuristic warm-up, exporting metadata only ...")
+                self.phase_export_meta()
+            else:
+                logger.warning(f"No '{best_model_name}' found — running v0 initialization ...")
+                self.phase_bootstrap()
+                self.wait_for_vram_cleanup()
+
+        return best_model_name, best_model_path, latest_model_path
+
     # ------------------------------------------------------------------
     # Main loop
     # ------------------------------------------------------------------
@@ -271,14 +315,7 @@ class OneMindArmyPipeline:
             f"{'='*60}"
         )
 
-        best_model_name = "best_model.plan"
-        best_model_path  = self.models_dir / best_model_name
-        latest_model_path = self.models_dir / "latest_model.plan"
-
-        if not best_model_path.exists():
-            logger.warning(f"No '{best_model_name}' found — running v0 initialization ...")
-            self.phase_bootstrap()
-            self.wait_for_vram_cleanup()
+        best_model_name, best_model_path, latest_model_path = self.prepare_models()
 
         pipeline_start = time.time()
         start_iter     = self.get_start_iteration()
@@ -302,13 +339,13 @@ class OneMindArmyPipeline:
             self.wait_for_vram_cleanup()
 
             if latest_model_path.exists():
-                shutil.copy(latest_model_path, best_model_path)
+                self.publish_model(latest_model_path, best_model_path)
                 logger.info(
                     f"[ContinuousDeployment] Overwriting {best_model_name} with newly trained weights. "
                     f"(iteration {iteration} complete)"
                 )
             else:
-                logger.error("latest_model.plan was not produced by train.py!")
+                logger.error(f"{latest_model_path.name} was not produced by train.py!")
                 sys.exit(1)
 
             iter_elapsed = time.time() - iter_start
@@ -322,6 +359,83 @@ class OneMindArmyPipeline:
             f"{'='*60}"
         )
 
+    def run_continuous(self, total_iterations: int):
+        """
+        training.continuous: one long-running self-play process. It writes
+        iteration_XXXX.bin.ready once the file holds gamesPerIteration games and
+        keeps appending; we train on the window, publish best_model, and the
+        C++ side hot-swaps it and rotates to the next iteration file.
+        Heuristic warm-up iterations still run through the classic loop.
+        """
+        heuristic_iters = self.config.get("backend", {}).get("heuristicIterations", 0)
+        start_iter = self.get_start_iteration()
+        if heuristic_iters > 0 and start_iter <= heuristic_iters:
+            warmup = min(heuristic_iters - start_iter + 1, total_iterations)
+            self.run_loop(warmup)
+            total_iterations -= warmup
+            if total_iterations <= 0:
+                return
+            start_iter = self.get_start_iteration()
+
+        best_model_name, best_model_path, latest_model_path = self.prepare_models()
+        poll_sec = float(self.config.get("training", {}).get("modelPollSec", 5.0))
+
+        logger.info(
+            f"\n{'='*60}\n"
+            f"  OMA CONTINUOUS PIPELINE START  —  game: {self.game_name.upper()}\n"
+            f"  Iterations {start_iter:04d} .. {start_iter + total_iterations - 1:04d}\n"
+            f"{'='*60}"
+        )
+
+        self.update_config_iteration(start_iter)
+        cmd = [str(self.cpp_engine_path), str(self.config_path), "--mode", "train", "--model", best_model_name]
+        logger.info(f"--- START : Continuous Self-Play  (model: {best_model_name}) ---")
+        proc = subprocess.Popen(cmd)
+
+        pipeline_start = time.time()
+        try:
+            for iteration in range(start_iter, start_iter + total_iterations):
+                iter_start = time.time()
+                ready_marker = self.data_dir / f"iteration_{iteration:04d}.bin.ready"
+                while not ready_marker.exists():
+                    if proc.poll() is not None:
+                        logger.error(f"Self-play exited early (code {proc.returncode}).")
+                        sys.exit(1)
+                    time.sleep(poll_sec)
+
+                # train.py reads currentIteration (LR schedule); the running self-play ignores the file.
+                self.update_config_iteration(iteration)
+                self.enforce_sliding_window()
+                self.phase_train()
+
+                if not latest_model_path.exists():
+                    logger.error(f"{latest_model_path.name} was not produced by train.py!")
+                    sys.exit(1)
+                self.publish_model(latest_model_path, best_model_path)
+                logger.info(
+                    f"[ContinuousDeployment] Published {best_model_name}; self-play hot-swaps it "
+                    f"and moves on to iteration {iteration + 1:04d}."
+                )
+
+                iter_elapsed = time.time() - iter_start
+                logger.info(f"[Iteration {iteration:04d}] Wall-clock time: {iter_elapsed/60:.1f} min")
+        finally:
+            if proc.poll() is None:
+                # SIGINT lets the handler flush the games it has buffered.
+                proc.send_signal(signal.SIGINT if platform.system() != "Windows" else signal.CTRL_C_EVENT)
+                try:
+                    proc.wait(timeout=120)
+                except subprocess.TimeoutExpired:
+                    proc.kill()
+
+        total_hours = (time.time() - pipeline_start) / 3600
+        logger.info(
+            f"\n{'='*60}\n"
+            f"  CONTINUOUS PIPELINE FINISHED\n"
+            f"  {total_iterations} iterations in {total_hours:.2f} hours\n"
+            f"{'='*60}"
+        )
+
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="OneMindArmy — Orchestrator")
@@ -337,7 +451,10 @@ if __name__ == "__main__":
     pipeline.wait_for_vram_cleanup(timeout_sec=5)
 
     try:
-        pipeline.run_loop(args.iterations)
+        if pipeline.config.get("training", {}).get("continuous", False):
+            pipeline.run_continuous(args.iterations)
+        else:
+            pipeline.run_loop(args.iterations)
     except KeyboardInterrupt:
         logger.warning("\n[Interrupted] Pipeline stopped by user. Cleaning up ...")
         pipeline.ensure_process_terminated()
@@ -6,6 +6,7 @@ import argparse
 import subprocess
 import glob
 import math
+import struct
 import torch
 import torch.nn as nn
 import torch.nn.functional as F
@@ -15,7 +16,7 @@ from pathlib import Path
 from torch.utils.data import DataLoader, ConcatDataset
 
 try:
-    from dataset import OneMindArmyDataset
+    from dataset import OneMindArmyDataset, check_uniform_layout
 except ImportError:
     print("[Fatal] dataset.py not found.")
     sys.exit(1)
@@ -91,6 +92,16 @@ class OneMindArmyNet(nn.Module):
             print(f"[Warning] nnInputSize ({self.nn_input_size}) not divisible by "
                   f"kTokenDim ({self.kTokenDim}).")
 
+        # Packed layout (StateEncoder::encodePacked). Constants only: no weights,
+        # so checkpoints load the same whichever layout the inputs come in.
+        self.num_facts      = meta.get("numFacts", 0)
+        self.pos_words      = meta.get("posWords", 0)
+        bits_per_word       = meta.get("posBitsPerWord", 8)
+        self.register_buffer("bit_scale",
+            2.0 ** torch.arange(bits_per_word, dtype=torch.float32), persistent=False)
+        self.register_buffer("pos_ids",
+            torch.arange(1, self.num_pos + 1, dtype=torch.float32), persistent=False)
+
         self.d_model  = config["network"].get("dModel",         256)
         self.n_heads  = config["network"].get("nHeads",         16)
         self.n_layers = config["network"].get("nLayers",        8)
@@ -123,7 +134,25 @@ class OneMindArmyNet(nn.Module):
             nn.Linear(64, self.num_players * 3),
         )
 
-    def forward(self, x):
+    def unpack_input(self, x):
+        """Packed rows -> dense tokens, with float ops only (exact in fp16)."""
+        x     = x.view(-1, self.seq_len, 4 + self.pos_words)
+        head  = x[..., :4]
+
+        # Fact tokens: bit b of word w -> position 8w + b.
+        q     = torch.floor(x[:, :self.num_facts, 4:].unsqueeze(-1) / self.bit_scale)
+        facts = (q - 2.0 * torch.floor(q * 0.5)).flatten(2)[..., :self.num_pos]
+
+        # Action tokens: [src+1, dst+1] -> -1 at src, +1 at dst (dst wins if equal).
+        src   = (x[:, self.num_facts:, 4:5] == self.pos_ids).float()
+        dst   = (x[:, self.num_facts:, 5:6] == self.pos_ids).float()
+        moves = dst - src * (1.0 - dst)
+
+        return torch.cat([head, torch.cat([facts, moves], dim=1)], dim=-1)
+
+    def forward(self, x, packed=False):
+        if packed:
+            x         = self.unpack_input(x)
         x             = x.view(-1, self.seq_len, self.kTokenDim)
         x             = self.embedding(x) + self.pos_encoder
         x             = self.transformer(x)
@@ -137,14 +166,20 @@ class OneMindArmyNet(nn.Module):
 # --- 3. EXPORT & COMPILATION ---
 # ==============================================================================
 
+def input_width(meta, layout):
+    """Floats per position in 'input_state' for backend.inputLayout."""
+    return meta["packedInputSize"] if layout == "packed" else meta["nnInputSize"]
+
+
 class ONNXExportWrapper(nn.Module):
-    def __init__(self, base_model, num_players: int):
+    def __init__(self, base_model, num_players: int, packed: bool = False):
         super().__init__()
         self.base_model  = base_model
         self.num_players = num_players
+        self.packed      = packed
 
     def forward(self, x):
-        policy_logits, wdl_logits = self.base_model(x)
+        policy_logits, wdl_logits = self.base_model(x, packed=self.packed)
 
         # On garde le softmax sur le WDL car c'est un très petit vecteur (sûr numériquement)
         B = wdl_logits.size(0)
@@ -155,14 +190,14 @@ class ONNXExportWrapper(nn.Module):
         # RETOURNE LES LOGITS DE POLITIQUE BRUTS (Pas de Softmax ici !)
         return policy_logits, wdl_probs
 
-def export_to_onnx(model, meta, save_path):
-    print(f"\n[Export] Saving ONNX → {save_path}")
+def export_to_onnx(model, meta, save_path, layout="dense"):
+    print(f"\n[Export] Saving ONNX ({layout} input) → {save_path}")
     model.eval()
-    wrapper = ONNXExportWrapper(model, meta["numPlayers"])
+    wrapper = ONNXExportWrapper(model, meta["numPlayers"], packed=(layout == "packed"))
     wrapper.eval()
 
     device      = next(model.parameters()).device
-    dummy_input = torch.randn(1, meta["nnInputSize"]).to(device)
+    dummy_input = torch.randn(1, input_width(meta, layout)).to(device)
     Path(save_path).parent.mkdir(parents=True, exist_ok=True)
 
     torch.onnx.export(
@@ -179,9 +214,9 @@ def export_to_onnx(model, meta, save_path):
     print("[Export] ONNX saved successfully.")
 
 
-def compile_tensorrt_engine(onnx_path, plan_path, meta, opt_batch, precision):
+def compile_tensorrt_engine(onnx_path, plan_path, meta, opt_batch, precision, layout="dense"):
     print(f"\n[TRT] Compiling  precision={precision.upper()}  batch={opt_batch} ...")
-    s   = meta["nnInputSize"]
+    s   = input_width(meta, layout)
     cmd = [
         "trtexec",
         f"--onnx={onnx_path}", f"--saveEngine={plan_path}",
@@ -200,6 +235,42 @@ def compile_tensorrt_engine(onnx_path, plan_path, meta, opt_batch, precision):
         sys.exit(1)
 
 
+def export_cpu_weights(model, meta, save_path):
+    """Flat fp32 dump read by the C++ CpuTransformerNet backend (format 'OMAW' v1)."""
+    print(f"\n[Export] Saving CPU weights → {save_path}")
+    model.eval()
+    layers = model.transformer.layers
+
+    header = struct.pack(
+        "<4s9I", b"OMAW", 1,
+        model.kTokenDim, model.seq_len, model.d_model, model.n_heads,
+        model.n_layers, model.dim_ff, meta["actionSpace"], meta["numPlayers"])
+
+    tensors = [model.embedding.weight, model.embedding.bias, model.pos_encoder]
+    for layer in layers:
+        tensors += [
+            layer.self_attn.in_proj_weight,  layer.self_attn.in_proj_bias,
+            layer.self_attn.out_proj.weight, layer.self_attn.out_proj.bias,
+            layer.linear1.weight, layer.linear1.bias,
+            layer.linear2.weight, layer.linear2.bias,
+            layer.norm1.weight,   layer.norm1.bias,
+            layer.norm2.weight,   layer.norm2.bias,
+        ]
+    tensors += [
+        model.policy_head[0].weight, model.policy_head[0].bias,
+        model.policy_head[2].weight, model.policy_head[2].bias,
+        model.value_head[0].weight,  model.value_head[0].bias,
+        model.value_head[2].weight,  model.value_head[2].bias,
+    ]
+
+    Path(save_path).parent.mkdir(parents=True, exist_ok=True)
+    with open(save_path, "wb") as f:
+        f.write(header)
+        for t in tensors:
+            f.write(t.detach().to("cpu", torch.float32).contiguous().numpy().astype("<f4").tobytes())
+    print("[Export] CPU weights saved successfully.")
+
+
 # ==============================================================================
 # --- 4. CHECKPOINT HELPERS ---
 # ==============================================================================
@@ -314,6 +385,8 @@ def run_training(config_path: str):
         meta = json.load(f)
 
     num_players = meta["numPlayers"]
+    packed      = meta.get("inputLayout", "dense") == "packed"
+    layout      = config["backend"].get("inputLayout", "dense")
 
     # 4. Hyperparameters -------------------------------------------------------
     train_batch_size  = hp.get("trainBatchSize",    1024)
@@ -345,7 +418,10 @@ def run_training(config_path: str):
 
     # 6. Dataset ---------------------------------------------------------------
     print(f"[Train] Loading {len(bin_files)} file(s)...")
-    full_dataset = ConcatDataset([OneMindArmyDataset(f) for f in bin_files])
+    datasets = [OneMindArmyDataset(f) for f in bin_files]
+    # Every file's own sidecar must agree with the layout the model consumes.
+    check_uniform_layout(datasets, "packed" if packed else "dense")
+    full_dataset = ConcatDataset(datasets)
     print(f"[Train] Total samples: {len(full_dataset):,}")
 
     dataloader = DataLoader(
@@ -358,6 +434,7 @@ def run_training(config_path: str):
     checkpoint_path = model_dir / "latest_checkpoint.pt"
     onnx_path       = model_dir / "latest_model.onnx"
     plan_path       = model_dir / "latest_model.plan"
+    weights_path    = model_dir / "latest_model.weights"
 
     model     = OneMindArmyNet(config, meta).to(device)
     optimizer = optim.AdamW(model.parameters(), lr=lr, weight_decay=weight_decay)
@@ -407,7 +484,7 @@ def run_training(config_path: str):
                 target_policies.sum(dim=-1, keepdim=True) + 1e-9)
 
             # Forward
-            policy_logits, wdl_logits = model(states)
+            policy_logits, wdl_logits = model(states, packed=packed)
 
             # ---- Policy loss (masked cross-entropy) ----
             policy_logits  = policy_logits.masked_fill(legal_masks == 0, -1e9)
@@ -471,12 +548,15 @@ def run_training(config_path: str):
 
     # 10. Save & export --------------------------------------------------------
     save_checkpoint(checkpoint_path, model, optimizer, global_step, current_iteration)
-    export_to_onnx(model, meta, str(onnx_path))
-    compile_tensorrt_engine(
-        str(onnx_path), str(plan_path), meta,
-        config["backend"].get("inferenceBatchSize", 1024),
-        config["backend"].get("precision", "fp16"),
-    )
+    export_to_onnx(model, meta, str(onnx_path), layout)
+    export_cpu_weights(model, meta, str(weights_path))
+    if config["backend"].get("inferenceBackend", "tensorrt") == "tensorrt":
+        compile_tensorrt_engine(
+            str(onnx_path), str(plan_path), meta,
+            config["backend"].get("inferenceBatchSize", 1024),
+            config["backend"].get("precision", "fp16"),
+            layout,
+        )
     print(f"\n[Train] Done. Log: {log_path}")
 
 
@@ -6,7 +6,10 @@
 #include <type_traits>
 #include <stdexcept>
 #include <yaml-cpp/yaml.h>
+
+#ifdef ONEMINDARMY_WITH_TENSORRT
 #include <cuda_runtime.h>
+#endif
 
 namespace Core
 {
@@ -126,6 +129,12 @@ namespace Core
 
         uint32_t currentIteration = 0;
 
+        // Continuous self-play: the train run never exits. The model file is polled
+        // every modelPollSec; a new version is loaded in the background, swapped into
+        // the inference backends, and the dataset rotates to the next iteration file.
+        bool  continuous = false;
+        float modelPollSec = 5.0f;
+
         void load(const YAML::Node& root, const std::string& runMode)
         {
             const auto& node = root["training"];
@@ -147,6 +156,9 @@ namespace Core
             drawSampleRate = loadVal<float>(node, "drawSampleRate", 0.0f, 1.0f);
 
             currentIteration = loadVal<uint32_t>(node, "currentIteration", 0u, UINT32_MAX);
+
+            if (node["continuous"]) continuous = loadVal<bool>(node, "continuous", false, true);
+            if (node["modelPollSec"]) modelPollSec = loadVal<float>(node, "modelPollSec", 0.1f, 3600.0f);
         }
     };
 
@@ -162,15 +174,102 @@ namespace Core
         float queueScale;
         bool fastDrain;
 
+        // Self-play concurrency controller. When enabled, numParallelGames becomes the
+        // slot ceiling and the handler starts/parks games at runtime to hold the targets.
+        bool     autoConcurrency = false;
+        uint32_t minParallelGames = 1;
+        float    targetBatchFill = 0.9f;
+        float    targetGpuDuty = 0.85f;
+        uint32_t maxWorkingSetMB = 0;    // 0 = unbounded
+
+        // Stage rebalancing. When enabled, numSearchThreads + numBackpropThreads form
+        // one budget whose workers migrate between the gather and backprop roles.
+        bool     rebalanceThreads = false;
+        uint32_t rebalanceIntervalMs = 250;
+
+        // Inference backend: "tensorrt" (one engine per GPU), "cpu" (fp32 transformer
+        // reading the .weights file exported next to the .plan), "synthetic" (hashed
+        // outputs behind a latency model, for pipeline benchmarks) or "heuristic" (the
+        // game's Evaluator, run inline on the search threads). cpuThreads: 0 = all cores.
+        // heuristicIterations: training iterations 1..N self-play with "heuristic".
+        std::string inferenceBackend = "tensorrt";
+        uint32_t    cpuThreads = 0;
+        uint32_t    heuristicIterations = 0;
+        float       syntheticFixedUs = 1000.0f;
+        float       syntheticPerItemUs = 5.0f;
+        float       syntheticJitter = 0.0f;
+
+        // Batches each inference thread keeps in flight (tensorrt/synthetic): while one
+        // computes, the next is packed and the previous unpacked. 1 = strictly sequential.
+        uint32_t    inflightBatches = 2;
+
+        // Two-tier cascade: leaves at depth >= cascadeDepth, or whose parent has fewer
+        // than cascadeVisits visits, are evaluated by a small network (cascadeModel, a
+        // file next to the main model) through its own queue and inference threads.
+        // Either criterion may be 0 (unused). Empty cascadeModel = one network for all.
+        std::string cascadeModel;
+        uint32_t    cascadeDepth = 0;
+        uint32_t    cascadeVisits = 0;
+        uint32_t    cascadeBatchSize = 0;  // 0 = inferenceBatchSize
+
+        // Row format of the tensorrt input ("dense" or "packed", see
+        // StateEncoder::encodePacked); must match how the .plan was exported.
+        // The cpu and synthetic backends always read dense rows.
+        std::string inputLayout = "dense";
+
+        // Leaf encoding: incremental = delta against the tree root's encoding (only
+        // changed fact tokens + the history window). Off by default: with the
+        // sparse full encoder the copy of the root's tokens costs about as much as
+        // re-encoding. verifyEncoder re-encodes every leaf from scratch as well and
+        // aborts on the first difference (debug aid).
+        bool        incrementalEncoding = false;
+        bool        verifyEncoder = false;
+
         void load(const YAML::Node& root, const std::string& /*runMode*/)
         {
             const auto& node = root["backend"];
             if (!node) throw std::runtime_error("Config Error: Missing 'backend' block (Always mandatory).");
 
+            if (node["inferenceBackend"]) {
+                inferenceBackend = node["inferenceBackend"].as<std::string>();
+                if (inferenceBackend != "tensorrt" && inferenceBackend != "cpu" && inferenceBackend != "synthetic"
+                    && inferenceBackend != "heuristic")
+                    throw std::runtime_error("Config Error: Unknown inferenceBackend '" + inferenceBackend
+                        + "'. Valid options are: tensorrt, cpu, synthetic, heuristic.");
+            }
+            if (node["heuristicIterations"])
+                heuristicIterations = loadVal<uint32_t>(node, "heuristicIterations", 0u, UINT32_MAX);
+            if (node["cpuThreads"]) cpuThreads = loadVal<uint32_t>(node, "cpuThreads", 0u, 1024u);
+            if (node["syntheticFixedUs"]) syntheticFixedUs = loadVal<float>(node, "syntheticFixedUs", 0.0f, 1e7f);
+            if (node["syntheticPerItemUs"]) syntheticPerItemUs = loadVal<float>(node, "syntheticPerItemUs", 0.0f, 1e6f);
+            if (node["syntheticJitter"]) syntheticJitter = loadVal<float>(node, "syntheticJitter", 0.0f, 1.0f);
+            if (node["inflightBatches"]) inflightBatches = loadVal<uint32_t>(node, "inflightBatches", 1u, 8u);
+
+            if (node["inputLayout"]) {
+                inputLayout = node["inputLayout"].as<std::string>();
+                if (inputLayout != "dense" && inputLayout != "packed")
+                    throw std::runtime_error("Config Error: Unknown inputLayout '" + inputLayout
+                        + "'. Valid options are: dense, packed.");
+            }
+            if (node["incrementalEncoding"]) incrementalEncoding = loadVal<bool>(node, "incrementalEncoding", false, true);
+            if (node["verifyEncoder"]) verifyEncoder = loadVal<bool>(node, "verifyEncoder", false, true);
+
+            if (node["cascadeModel"]) cascadeModel = node["cascadeModel"].as<std::string>();
+            if (!cascadeModel.empty()) {
+                if (node["cascadeDepth"]) cascadeDepth = loadVal<uint32_t>(node, "cascadeDepth", 0u, UINT16_MAX);
+                if (node["cascadeVisits"]) cascadeVisits = loadVal<uint32_t>(node, "cascadeVisits", 0u, UINT32_MAX);
+                if (node["cascadeBatchSize"]) cascadeBatchSize = loadVal<uint32_t>(node, "cascadeBatchSize", 0u, UINT32_MAX);
+                if (cascadeDepth == 0 && cascadeVisits == 0)
+                    throw std::runtime_error("Config Error: cascadeModel needs cascadeDepth and/or cascadeVisits.");
+            }
+
             // Auto-detect hardware limits to prevent allocation crashes
+            uint32_t availableGPUs = 1u;
+#ifdef ONEMINDARMY_WITH_TENSORRT
             int cudaCount = 0;
             cudaError_t err = cudaGetDeviceCount(&cudaCount);
-            uint32_t availableGPUs = (err == cudaSuccess && cudaCount > 0) ? static_cast<uint32_t>(cudaCount) : 1u;
+            if (err == cudaSuccess && cudaCount > 0) availableGPUs = static_cast<uint32_t>(cudaCount);
+#endif
 
             try {
                 if (node["numGPUs"]) {
@@ -198,6 +297,23 @@ namespace Core
             numInferenceThreads = loadVal<uint32_t>(node, "numInferenceThreads", 1u, 1024u);
             queueScale = loadVal<float>(node, "queueScale", 1.0f, 100.0f);
             fastDrain = loadVal<bool>(node, "fastDrain", false, true);
+
+            // Optional block: legacy configs keep the static numParallelGames behaviour.
+            if (node["autoConcurrency"]) {
+                autoConcurrency = loadVal<bool>(node, "autoConcurrency", false, true);
+                if (autoConcurrency) {
+                    minParallelGames = loadVal<uint32_t>(node, "minParallelGames", 1u, numParallelGames);
+                    targetBatchFill = loadVal<float>(node, "targetBatchFill", 0.05f, 1.0f);
+                    targetGpuDuty = loadVal<float>(node, "targetGpuDuty", 0.05f, 1.0f);
+                    maxWorkingSetMB = loadVal<uint32_t>(node, "maxWorkingSetMB", 0u, UINT32_MAX);
+                }
+            }
+
+            if (node["rebalanceThreads"]) {
+                rebalanceThreads = loadVal<bool>(node, "rebalanceThreads", false, true);
+                if (rebalanceThreads)
+                    rebalanceIntervalMs = loadVal<uint32_t>(node, "rebalanceIntervalMs", 10u, 60000u);
+            }
         }
     };
 
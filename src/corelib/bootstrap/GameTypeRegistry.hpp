@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <stdexcept>
@@ -11,9 +12,14 @@
 #include "../interfaces/IHandler.hpp"
 #include "../model/ThreadPool.hpp"
 #include "../model/TreeSearch.hpp"
-#include "../model/NeuralNet.hpp"
+#include "../model/CpuTransformerNet.hpp"
+#include "../model/SyntheticNet.hpp"
 #include "GameConfig.hpp" 
 
+#ifdef ONEMINDARMY_WITH_TENSORRT
+#include "../model/NeuralNet.hpp"
+#endif
+
 #include "../handlers/SelfPlayHandler.hpp"
 #include "../handlers/InferenceHandler.hpp"
 #include "../handlers/MetaExportHandler.hpp"
@@ -28,6 +34,23 @@ namespace Core
     template <typename T>
     struct has_custom_handler<T, std::void_t<typename T::Handler>> : std::true_type {};
 
+    // SFINAE check: Determines if a game ships a heuristic leaf Evaluator
+    // (required by inferenceBackend: heuristic).
+    template <typename, typename = void>
+    struct has_evaluator : std::false_type {};
+
+    template <typename T>
+    struct has_evaluator<T, std::void_t<typename T::Evaluator>> : std::true_type {};
+
+    // Swaps the trailing extension of a model path (e.g. best_model.plan -> best_model.weights).
+    inline std::string replaceExtension(const std::string& path, const std::string& ext)
+    {
+        const size_t slash = path.find_last_of("/\\");
+        const size_t dot = path.find_last_of('.');
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return path + ext;
+        return path.substr(0, dot) + ext;
+    }
+
     // ========================================================================
     // GAME BOOTSTRAPPER 
     // Acts as a Dependency Injection container. It resolves concrete types 
@@ -47,6 +70,50 @@ namespace Core
 
         explicit GameBootstrapper(const std::string& name) : m_name(name) {}
 
+        // File the selected backend actually reads (the CPU backend loads the .weights dump).
+        static std::string modelFileFor(const BackendConfig& backendCfg, const std::string& modelPath)
+        {
+            return backendCfg.inferenceBackend == "cpu" ? replaceExtension(modelPath, ".weights") : modelPath;
+        }
+
+        // Instantiates the inference backend(s) selected by 'backend.inferenceBackend'.
+        static AlignedVec<std::unique_ptr<IInferenceBackend<GT>>> buildBackends(
+            const BackendConfig& backendCfg, const NetworkConfig& netCfg, const std::string& modelPath)
+        {
+            AlignedVec<std::unique_ptr<IInferenceBackend<GT>>> backends;
+
+            // Every inference thread driving a backend gets its own range of batch slots.
+            const uint32_t numSlots = backendCfg.inflightBatches * backendCfg.numInferenceThreads;
+
+            // Leaves are evaluated inline by the search threads: no inference workers.
+            if (backendCfg.inferenceBackend == "heuristic") return backends;
+
+            if (backendCfg.inferenceBackend == "cpu") {
+                backends.push_back(std::make_unique<CpuTransformerNet<GT>>(
+                    modelFileFor(backendCfg, modelPath), netCfg, backendCfg.inferenceBatchSize, backendCfg.cpuThreads, numSlots));
+                return backends;
+            }
+
+            if (backendCfg.inferenceBackend == "synthetic") {
+                const SyntheticLatency latency{ backendCfg.syntheticFixedUs, backendCfg.syntheticPerItemUs,
+                    backendCfg.syntheticJitter };
+                backends.push_back(std::make_unique<SyntheticNet<GT>>(backendCfg.inferenceBatchSize, latency, numSlots));
+                return backends;
+            }
+
+#ifdef ONEMINDARMY_WITH_TENSORRT
+            const InputLayout layout = backendCfg.inputLayout == "packed" ? InputLayout::Packed : InputLayout::Dense;
+            backends.reserve(backendCfg.numGPUs);
+            for (uint32_t i = 0; i < backendCfg.numGPUs; ++i) {
+                backends.push_back(std::make_unique<NeuralNet<GT>>(i, backendCfg.inferenceBatchSize, modelPath, numSlots, layout));
+            }
+            return backends;
+#else
+            throw std::runtime_error("Fatal Error: inferenceBackend 'tensorrt' requested, but this binary was "
+                "built without TensorRT (ONEMINDARMY_WITH_TENSORRT=OFF). Use inferenceBackend: cpu.");
+#endif
+        }
+
         void run(const YAML::Node& config, const std::string& mode, const std::string& modelPath) const override
         {
             std::cout << "\n[Bootstrapper] Initializing Game Module: [" << m_name << "]\n";
@@ -60,9 +127,12 @@ namespace Core
 
             // Dynamically route to the correct execution loop based on CLI arguments
             std::unique_ptr<IHandler<GT>> handler;
+            SelfPlayHandler<GT>* selfPlay = nullptr;
 
             if (mode == "train") {
-                handler = std::make_unique<SelfPlayHandler<GT>>();
+                auto concrete = std::make_unique<SelfPlayHandler<GT>>();
+                selfPlay = concrete.get();
+                handler = std::move(concrete);
             }
             else if (mode == "play") {
                 handler = std::make_unique<InferenceHandler<GT>>();
@@ -88,16 +158,47 @@ namespace Core
             std::unique_ptr<ThreadPool<GT>> threadPool = nullptr;
             AlignedVec<std::unique_ptr<TreeSearch<GT>>> treeSearches;
 
-            if (mode != "export-meta")
-            {
-                AlignedVec<std::unique_ptr<NeuralNet<GT>>> neuralNets;
-                neuralNets.reserve(backendConfig.numGPUs);
-                for (uint32_t i = 0; i < backendConfig.numGPUs; ++i) {
-                    neuralNets.push_back(std::make_unique<NeuralNet<GT>>(i, backendConfig.inferenceBatchSize, modelPath));
+            // Warm-up: the first training iterations need no network at all.
+            if (mode == "train" && backendConfig.heuristicIterations > 0
+                && trainingConfig.currentIteration <= backendConfig.heuristicIterations) {
+                std::cout << "[Bootstrapper] Iteration " << trainingConfig.currentIteration
+                    << " <= heuristicIterations: self-play uses the heuristic evaluator.\n";
+                backendConfig.inferenceBackend = "heuristic";
+            }
+
+            std::shared_ptr<const IEvaluator<GT>> evaluator = nullptr;
+            if (mode != "export-meta" && backendConfig.inferenceBackend == "heuristic") {
+                if constexpr (has_evaluator<GameConfig>::value) {
+                    auto concrete = std::make_shared<typename GameConfig::Evaluator>();
+                    concrete->setup(config);
+                    evaluator = std::move(concrete);
+                }
+                else {
+                    throw std::runtime_error("Config Error: inferenceBackend 'heuristic' requested, but game '"
+                        + m_name + "' defines no 'Evaluator' type.");
                 }
+            }
+
+            // Cascade tier: same backend kind, its own model file and batch size. The
+            // small network's shape comes from its own file, not the 'network' block.
+            AlignedVec<std::unique_ptr<IInferenceBackend<GT>>> fastBackends;
+            if (mode != "export-meta" && !backendConfig.cascadeModel.empty()
+                && backendConfig.inferenceBackend != "heuristic") {
+                BackendConfig fastCfg = backendConfig;
+                if (fastCfg.cascadeBatchSize > 0) fastCfg.inferenceBatchSize = fastCfg.cascadeBatchSize;
+                const std::string fastPath =
+                    (std::filesystem::path(modelPath).parent_path() / backendConfig.cascadeModel).string();
+
+                std::cout << "[Bootstrapper] Cascade: leaves at depth >= " << backendConfig.cascadeDepth
+                    << " or parent visits < " << backendConfig.cascadeVisits << " use " << fastPath << "\n";
+                fastBackends = buildBackends(fastCfg, NetworkConfig{}, fastPath);
+            }
 
+            if (mode != "export-meta")
+            {
                 threadPool = std::make_unique<ThreadPool<GT>>(
-                    engine, std::move(neuralNets), backendConfig, engineConfig
+                    engine, buildBackends(backendConfig, networkConfig, modelPath), backendConfig, engineConfig,
+                    std::move(fastBackends)
                 );
 
                 // Exact tree allocation calculation to optimize VRAM footprint:
@@ -111,6 +212,8 @@ namespace Core
                 treeSearches.reserve(numTreesNeeded);
                 for (uint32_t i = 0; i < numTreesNeeded; ++i) {
                     treeSearches.push_back(std::make_unique<TreeSearch<GT>>(engine, engineConfig));
+                    treeSearches.back()->setIncrementalEncoding(backendConfig.incrementalEncoding);
+                    if (evaluator) treeSearches.back()->setEvaluator(evaluator);
                 }
             }
 
@@ -127,6 +230,14 @@ namespace Core
                 requester->setup(config);
             }
 
+            // Continuous self-play reloads the model through the same factory.
+            if (selfPlay && trainingConfig.continuous && backendConfig.inferenceBackend != "heuristic") {
+                selfPlay->setModelSource(modelFileFor(backendConfig, modelPath),
+                    [backendConfig, networkConfig, modelPath] {
+                        return buildBackends(backendConfig, networkConfig, modelPath);
+                    });
+            }
+
             // Inject all dependencies into the selected pipeline handler
             handler->setup(
                 config, engine, std::move(treeSearches), std::move(threadPool),
@@ -54,11 +54,22 @@ namespace Core
                 // Exports the exact memory footprint of the C++ TrainingSample struct.
                 // This accounts for OS/Compiler specific memory padding, guaranteeing 
                 // safe and perfectly aligned binary deserialization on the Python side.
+                // nnInput is stored packed (StateEncoder::encodePacked); nnInputSize
+                // remains the dense width the network's embedding consumes. Each
+                // iteration file also carries its own layout (DatasetLayout), which
+                // is what the readers trust for the stride.
                 metaFile << "{\n"
                     << "  \"numPlayers\": " << Defs::kNumPlayers << ",\n"
                     << "  \"numPos\": " << Defs::kNumPos << ",\n"
                     << "  \"actionSpace\": " << Defs::kActionSpace << ",\n"
                     << "  \"nnInputSize\": " << Defs::kNNInputSize << ",\n"
+                    << "  \"numFacts\": " << Defs::kMaxFacts << ",\n"
+                    << "  \"maxHistory\": " << Defs::kMaxHistory << ",\n"
+                    << "  \"formatVersion\": " << DatasetLayout<GT>::kFormatVersion << ",\n"
+                    << "  \"inputLayout\": \"packed\",\n"
+                    << "  \"posBitsPerWord\": " << Defs::kPosBitsPerWord << ",\n"
+                    << "  \"posWords\": " << Defs::kPosWords << ",\n"
+                    << "  \"packedInputSize\": " << Defs::kPackedInputSize << ",\n"
                     << "  \"sizeofTrainingSample\": " << sizeof(TrainingSample<GT>) << "\n"
                     << "}\n";
                 metaFile.close();
@@ -16,6 +16,8 @@
 #include <sstream>
 #include <cmath>
 #include <cstdio>
+#include <functional>
+#include <future>
 
 #include "../interfaces/IHandler.hpp"
 #include "../model/ReplayBuffer.hpp"
@@ -45,6 +47,8 @@ namespace Core
     {
     public:
         USING_GAME_TYPES(GT);
+        using Backends = AlignedVec<std::unique_ptr<IInferenceBackend<GT>>>;
+        using BackendLoader = std::function<Backends()>;
 
     private:
         struct GameContext
@@ -60,6 +64,149 @@ namespace Core
 
             uint32_t turnCount = 0;
             bool     isOfficial = false; // Prevents over-generation past target quota
+            bool     isActive = true;    // Parked slots are skipped by the search loop
+        };
+
+        // --------------------------------------------------------------------
+        // CONCURRENCY CONTROLLER
+        // Chooses how many game slots are in flight. Each active game contributes
+        // roughly one leaf per pipeline round-trip, so concurrency directly sets
+        // batch fill; too many games only deepen the eval queue, inflating RAM
+        // and per-move latency without adding GPU work.
+        //
+        // Control law (evaluated over windows of at least kWindowSec):
+        //   - Working set above ceiling       -> shrink by 1/8 (hard constraint)
+        //   - Batch fill or GPU duty under target -> grow by 1/16
+        //   - Both on target and a full batch still queued after each pop
+        //                                     -> shrink by 1/32 (latency trim)
+        // Shrinking parks slots at their next game boundary, never mid-game.
+        // --------------------------------------------------------------------
+        struct ConcurrencyController
+        {
+            static constexpr double kWindowSec = 0.5;
+
+            uint32_t target = 0;
+            uint32_t minSlots = 1;
+            uint32_t maxSlots = 1;
+
+            float  lastFill = 0.0f;
+            float  lastDuty = 0.0f;
+            size_t lastWorkingSet = 0;
+
+            PipelineStats prev;
+            std::chrono::steady_clock::time_point prevTime;
+
+            void init(const BackendConfig& cfg, uint32_t numInferenceWorkers)
+            {
+                maxSlots = cfg.numParallelGames;
+                minSlots = std::min(cfg.minParallelGames, maxSlots);
+
+                // Start with just enough games to fill every inference worker once.
+                const uint64_t seed = static_cast<uint64_t>(cfg.inferenceBatchSize) * std::max(1u, numInferenceWorkers);
+                target = static_cast<uint32_t>(std::clamp<uint64_t>(seed, minSlots, maxSlots));
+                prevTime = std::chrono::steady_clock::now();
+            }
+
+            // Returns true when the target changed.
+            bool update(const PipelineStats& now, size_t workingSet, const BackendConfig& cfg, uint32_t numInferenceWorkers)
+            {
+                const auto t = std::chrono::steady_clock::now();
+                const double wall = std::chrono::duration<double>(t - prevTime).count();
+                lastWorkingSet = workingSet;
+                if (wall < kWindowSec) return false;
+
+                const uint64_t dBatches = now.batches - prev.batches;
+                const uint64_t dItems = now.items - prev.items;
+                const uint64_t dBusyNs = now.busyNs - prev.busyNs;
+                const uint64_t dBacklog = now.backlogSum - prev.backlogSum;
+                prev = now;
+                prevTime = t;
+
+                if (dBatches == 0) return false;
+
+                lastFill = static_cast<float>(static_cast<double>(dItems) / (static_cast<double>(dBatches) * cfg.inferenceBatchSize));
+                lastDuty = static_cast<float>(static_cast<double>(dBusyNs) * 1e-9 / (wall * std::max(1u, numInferenceWorkers)));
+                const double avgBacklog = static_cast<double>(dBacklog) / static_cast<double>(dBatches);
+
+                if (!cfg.autoConcurrency) return false;
+
+                const uint32_t old = target;
+                const uint64_t ceiling = static_cast<uint64_t>(cfg.maxWorkingSetMB) << 20;
+
+                if (ceiling > 0 && workingSet > ceiling) {
+                    target -= std::max(1u, target / 8);
+                }
+                else if (lastFill < cfg.targetBatchFill || lastDuty < cfg.targetGpuDuty) {
+                    // Only grow while there is headroom under the memory ceiling.
+                    const size_t perGame = target > 0 ? workingSet / target : 0;
+                    if (ceiling == 0 || workingSet + perGame * std::max(1u, target / 16) <= ceiling)
+                        target += std::max(1u, target / 16);
+                }
+                else if (avgBacklog >= cfg.inferenceBatchSize) {
+                    target -= std::max(1u, target / 32);
+                }
+
+                target = std::clamp(target, minSlots, maxSlots);
+                return target != old;
+            }
+        };
+
+        // --------------------------------------------------------------------
+        // MODEL WATCHER (continuous mode)
+        // Polls the model file's timestamp and size. A change is only reported
+        // once it has held for a full poll period, so a file still being
+        // written (train.py export, plain copy) is never picked up half-done.
+        // --------------------------------------------------------------------
+        struct ModelWatcher
+        {
+            using Clock = std::chrono::steady_clock;
+
+            std::string path;
+            Clock::duration period{};
+            Clock::time_point nextPoll{};
+
+            std::filesystem::file_time_type seenTime{}, candTime{};
+            std::uintmax_t seenSize = 0, candSize = 0;
+            bool hasCandidate = false;
+
+            void init(const std::string& file, float periodSec)
+            {
+                path = file;
+                period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(periodSec));
+                nextPoll = Clock::now() + period;
+                stat(seenTime, seenSize);
+            }
+
+            bool stat(std::filesystem::file_time_type& t, std::uintmax_t& size) const
+            {
+                std::error_code ec;
+                t = std::filesystem::last_write_time(path, ec);
+                if (ec) return false;
+                size = std::filesystem::file_size(path, ec);
+                return !ec;
+            }
+
+            // Returns true when a new, settled version of the file is available.
+            bool poll()
+            {
+                const auto now = Clock::now();
+                if (now < nextPoll) return false;
+                nextPoll = now + period;
+
+                std::filesystem::file_time_type t;
+                std::uintmax_t size = 0;
+                if (!stat(t, size)) return false;
+
+                if (t == seenTime && size == seenSize) { hasCandidate = false; return false; }
+                if (hasCandidate && t == candTime && size == candSize) {
+                    seenTime = t; seenSize = size;
+                    hasCandidate = false;
+                    return true;
+                }
+                candTime = t; candSize = size;
+                hasCandidate = true;
+                return false;
+            }
         };
 
         // Captures MCTS metrics immediately after search completes.
@@ -80,14 +227,20 @@ namespace Core
             uint64_t totalSamples = 0;
             uint64_t totalPlies = 0;
             bool firstDraw = true;
+
+            uint32_t activeGames = 0;
         };
 
         BackendConfig  m_backendCfg;
         TrainingConfig m_trainingCfg;
+        std::string    m_dataFolder;
         std::string    m_datasetPath;
 
+        std::string    m_modelFile;      // Continuous mode: file watched for new versions
+        BackendLoader  m_backendLoader;  // Builds backends from the current model file
+
         static constexpr int kBoxWidth = 60;
-        static constexpr int kDashLines = 14;
+        static constexpr int kDashLines = 17;
 
         void specificSetup(const YAML::Node& config) override
         {
@@ -97,14 +250,50 @@ namespace Core
             m_trainingCfg.load(config, "train");
 
             const std::string gameName = config["name"].as<std::string>();
-            const std::string dataFolder = "data/" + gameName;
-            std::filesystem::create_directories(dataFolder);
+            m_dataFolder = "data/" + gameName;
+            std::filesystem::create_directories(m_dataFolder);
 
+            m_datasetPath = datasetPathFor(m_trainingCfg.currentIteration);
+        }
+
+        [[nodiscard]] std::string datasetPathFor(uint32_t iteration) const
+        {
             std::ostringstream oss;
-            oss << dataFolder << "/iteration_"
+            oss << m_dataFolder << "/iteration_"
                 << std::setw(4) << std::setfill('0')
-                << m_trainingCfg.currentIteration << ".bin";
-            m_datasetPath = oss.str();
+                << iteration << ".bin";
+            return oss.str();
+        }
+
+        // Continuous mode: closes the current dataset and appends to the next
+        // iteration's file. Games in progress carry their buffered turns over.
+        void rotateDataset(std::ofstream& outFile)
+        {
+            outFile.close();
+            m_datasetPath = datasetPathFor(++m_trainingCfg.currentIteration);
+            DatasetLayout<GT>::prepare(m_datasetPath);
+            outFile.open(m_datasetPath, std::ios::binary | std::ios::app);
+            if (!outFile.is_open())
+                throw std::runtime_error(
+                    "[SelfPlayHandler] Cannot open dataset for writing: " + m_datasetPath);
+        }
+
+        // Continuous mode: tells the orchestrator that the current file holds
+        // gamesPerIteration games and training may start (self-play keeps appending).
+        void markDatasetReady(std::ofstream& outFile) const
+        {
+            outFile.flush();
+            std::ofstream(m_datasetPath + ".ready").put('\n');
+        }
+
+        // Node storage is counted at its allocated size, not at what the search
+        // touched, since that is what the process holds. Parked slots hold none.
+        [[nodiscard]] static size_t gameWorkingSet(const GameContext& g)
+        {
+            size_t bytes = g.replayBuffer.size() * sizeof(TrainingSample<GT>);
+            for (size_t p = 0; p < Defs::kNumPlayers; ++p)
+                bytes += g.trees[p]->getReservedBytes();
+            return bytes;
         }
 
         void resetGame(GameContext& g)
@@ -122,6 +311,21 @@ namespace Core
                 g.trees[p]->startSearch(g.currentState, g.hashHistory);
         }
 
+        // Takes a slot out of the search loop and frees its trees' node storage;
+        // resetGame brings it back.
+        void parkGame(GameContext& g)
+        {
+            g.replayBuffer.clear();
+            g.actionHistory.clear();
+            g.hashHistory.clear();
+            g.turnCount = 0;
+            g.isOfficial = false;
+            g.isActive = false;
+
+            for (size_t p = 0; p < Defs::kNumPlayers; ++p)
+                g.trees[p]->releaseStorage();
+        }
+
         // --- Terminal Dashboard Formatting Helpers ---
 
         static std::string progressBar(double ratio, int width = 20)
@@ -193,7 +397,7 @@ namespace Core
 
         // Renders dashboard in-place using ANSI escape codes to prevent flickering.
         void printDashboard(DashboardState& d, uint32_t target,
-            double elapsed, const DashSnap& snap) const
+            double elapsed, const DashSnap& snap, const ConcurrencyController& cc) const
         {
             static const std::string HL = "═";
             static const std::string CL = "\033[K";
@@ -288,18 +492,56 @@ namespace Core
 
             {
                 std::snprintf(buf, sizeof(buf),
-                    "Threads  Search:%-3u  Infer:%-3u  Backprop:%-3u",
-                    m_backendCfg.numSearchThreads,
-                    m_backendCfg.numInferenceThreads,
-                    m_backendCfg.numBackpropThreads);
+                    "Threads  Search:%-3u  Infer:%-3u  Backprop:%-3u %s",
+                    this->m_threadPool->getNumGatherWorkers(),
+                    this->m_threadPool->getNumInferenceWorkers(),
+                    this->m_threadPool->getNumBackpropWorkers(),
+                    m_backendCfg.rebalanceThreads ? "(auto)" : "");
+                o << CL << boxRow(buf);
+            }
+
+            if (m_backendCfg.rebalanceThreads) {
+                const RebalanceStats rs = this->m_threadPool->getRebalanceStats();
+                std::snprintf(buf, sizeof(buf),
+                    "Stages  : idle Search %3.0f%%  Backprop %3.0f%%  |  moves %u",
+                    rs.idleGather * 100.0f, rs.idleBackprop * 100.0f, rs.moves);
+            }
+            else {
+                std::snprintf(buf, sizeof(buf), "Stages  : fixed split (rebalanceThreads off)");
+            }
+            o << CL << boxRow(buf);
+
+            {
+                const auto recent = this->m_threadPool->getRecentRoleChanges();
+                if (recent.empty()) {
+                    std::snprintf(buf, sizeof(buf), "Last    : no role change");
+                }
+                else {
+                    const RoleChange& rc = recent.back();
+                    std::snprintf(buf, sizeof(buf),
+                        "Last    : w%-2u %s  readyQ %.1f  bpQ %.1f  idle %.0f%%/%.0f%%",
+                        rc.worker, rc.toBackprop ? "G->B" : "B->G",
+                        rc.avgReadyQueue, rc.avgBackpropQueue,
+                        rc.idleGather * 100.0f, rc.idleBackprop * 100.0f);
+                }
                 o << CL << boxRow(buf);
             }
 
             {
                 std::snprintf(buf, sizeof(buf),
-                    "Batch   : %4u   |  Parallel games : %4u",
+                    "Batch   : %4u   |  Parallel games : %4u / %-4u %s",
                     m_backendCfg.inferenceBatchSize,
-                    m_backendCfg.numParallelGames);
+                    d.activeGames,
+                    m_backendCfg.numParallelGames,
+                    m_backendCfg.autoConcurrency ? "auto" : "");
+                o << CL << boxRow(buf);
+            }
+
+            {
+                std::snprintf(buf, sizeof(buf),
+                    "Fill    : %5.1f%%  |  GPU duty : %5.1f%%  |  RAM : %.2fG",
+                    cc.lastFill * 100.0f, cc.lastDuty * 100.0f,
+                    static_cast<double>(cc.lastWorkingSet) / (1024.0 * 1024.0 * 1024.0));
                 o << CL << boxRow(buf);
             }
 
@@ -363,24 +605,51 @@ namespace Core
         SelfPlayHandler() = default;
         ~SelfPlayHandler() = default;
 
+        // Enables model hot-swap in continuous mode. 'loader' runs on a
+        // background thread and must return backends shaped like the live ones.
+        void setModelSource(const std::string& modelFile, BackendLoader loader)
+        {
+            m_modelFile = modelFile;
+            m_backendLoader = std::move(loader);
+        }
+
         void execute() override
         {
             std::signal(SIGINT, sigintHandler);
             const uint32_t target = m_trainingCfg.gamesPerIteration;
 
+            // Continuous mode keeps every game official: the quota only marks the
+            // file ready for training, and the run ends on SIGINT. Without a network
+            // to reload (heuristic warm-up) it falls back to a one-shot iteration.
+            const bool continuous = m_trainingCfg.continuous && m_backendLoader
+                && this->m_threadPool->getNumInferenceWorkers() > 0;
+            if (m_trainingCfg.continuous && !continuous)
+                std::cout << "[SelfPlayHandler] No network backend to hot-swap: running a single iteration.\n";
+
+            ConcurrencyController cc;
+            const uint32_t numInferWorkers = this->m_threadPool->getNumInferenceWorkers();
+            cc.init(m_backendCfg, numInferWorkers);
+            cc.prev = this->m_threadPool->getPipelineStats();
+            if (!m_backendCfg.autoConcurrency) cc.target = m_backendCfg.numParallelGames;
+
+            // Slots beyond the controller's target start parked, so their trees
+            // never allocate node storage until they are woken.
             std::vector<GameContext> games(m_backendCfg.numParallelGames);
             size_t treeAllocIdx = 0;
-            for (auto& g : games) {
+            for (size_t i = 0; i < games.size(); ++i) {
+                GameContext& g = games[i];
                 for (size_t p = 0; p < Defs::kNumPlayers; ++p)
                     g.trees[p] = this->m_treeSearch[treeAllocIdx++].get();
 
                 g.actionHistory.reserve(Defs::kMaxHistory * 2);
-                resetGame(g);
+                if (i < cc.target) resetGame(g);
+                else               parkGame(g);
             }
 
-            for (size_t i = 0; i < games.size() && i < static_cast<size_t>(target); ++i)
+            for (size_t i = 0; i < cc.target && (continuous || i < static_cast<size_t>(target)); ++i)
                 games[i].isOfficial = true;
 
+            DatasetLayout<GT>::prepare(m_datasetPath);
             std::ofstream outFile(m_datasetPath, std::ios::binary | std::ios::app);
             if (!outFile.is_open())
                 throw std::runtime_error(
@@ -390,18 +659,50 @@ namespace Core
             std::vector<TreeSearch<GT>*> activeTrees;
             activeTrees.reserve(m_backendCfg.numParallelGames);
 
+            // One ply of every active game is applied and scored as a single engine batch.
+            struct PlyStep { GameContext* game; uint32_t player; float resignQ; };
+            std::vector<PlyStep>                    steps;
+            std::vector<Action>                     stepActions;
+            std::vector<State*>                     stepStates;
+            std::vector<std::span<const uint64_t>>  stepHashes;
+            std::vector<std::optional<GameResult>>  stepResults;
+            steps.reserve(m_backendCfg.numParallelGames);
+            stepActions.reserve(m_backendCfg.numParallelGames);
+            stepStates.reserve(m_backendCfg.numParallelGames);
+            stepHashes.reserve(m_backendCfg.numParallelGames);
+            stepResults.reserve(m_backendCfg.numParallelGames);
+
             DashboardState dash;
-            const auto startTime = std::chrono::high_resolution_clock::now();
+            auto startTime = std::chrono::high_resolution_clock::now();
+            auto wantGames = [&] { return continuous || dash.gamesWritten < target; };
+
+            ModelWatcher watcher;
+            if (continuous) watcher.init(m_modelFile, m_trainingCfg.modelPollSec);
+            std::future<Backends> pendingLoad;  // Joined on exit if a load is still running
+            bool readyMarked = false;
 
             std::cout << std::string(kDashLines, '\n');
+            this->m_threadPool->setRoleChangeEcho(false);
 
-            while (dash.gamesWritten < target
-                && g_keepRunning.load(std::memory_order_acquire))
+            while (wantGames() && g_keepRunning.load(std::memory_order_acquire))
             {
+                // Wake parked slots up to the controller's current target.
+                uint32_t activeCount = 0;
+                for (auto& g : games) {
+                    if (!g.isActive && activeCount < cc.target) {
+                        resetGame(g);
+                        g.isActive = true;
+                        g.isOfficial = wantGames();
+                    }
+                    if (g.isActive) ++activeCount;
+                }
+                dash.activeGames = activeCount;
+
                 activeTrees.clear();
                 for (const auto& g : games)
-                    activeTrees.push_back(
-                        g.trees[this->m_engine->getCurrentPlayer(g.currentState)]);
+                    if (g.isActive)
+                        activeTrees.push_back(
+                            g.trees[this->m_engine->getCurrentPlayer(g.currentState)]);
 
                 this->m_threadPool->executeMultipleTrees(
                     activeTrees, this->m_engineCfg.numSimulations);
@@ -414,8 +715,13 @@ namespace Core
                     snap.memPct = static_cast<int>(t->getMemoryUsage() * 100.0f);
                 }
 
+                steps.clear();
+                stepActions.clear();
+                stepStates.clear();
                 for (auto& g : games)
                 {
+                    if (!g.isActive) continue;
+
                     const uint32_t cp = this->m_engine->getCurrentPlayer(g.currentState);
                     TreeSearch<GT>* activeTree = g.trees[cp];
 
@@ -436,8 +742,9 @@ namespace Core
                             povHistory.push_back(a);
                         }
 
-                        std::array<float, Defs::kNNInputSize> encoded;
-                        StateEncoder<GT>::encode(povState, povHistory, encoded);
+                        // Samples are stored packed; the trainer unpacks them on the device.
+                        std::array<float, Defs::kPackedInputSize> encoded;
+                        StateEncoder<GT>::encodePacked(povState, povHistory, encoded);
 
                         g.replayBuffer.recordTurn(
                             encoded,
@@ -451,31 +758,50 @@ namespace Core
                         ? 1.0f : 0.0f;
 
                     const Action action = activeTree->selectMove(temperature);
-                    const float resignQ = activeTree->getRootValue();
+                    steps.push_back({ &g, cp, activeTree->getRootValue() });
+                    stepActions.push_back(action);
+                    stepStates.push_back(&g.currentState);
+                }
+
+                this->m_engine->applyActionBatch(stepActions, stepStates);
+
+                stepHashes.clear();
+                for (size_t i = 0; i < steps.size(); ++i)
+                {
+                    GameContext& g = *steps[i].game;
+                    const Action& action = stepActions[i];
 
                     g.turnCount++;
                     dash.totalMoves++;
 
-                    this->m_engine->applyAction(action, g.currentState);
                     g.hashHistory.push_back(g.currentState.hash());
                     g.actionHistory.push_back(action);
 
                     for (size_t p = 0; p < Defs::kNumPlayers; ++p)
                         g.trees[p]->advanceRoot(action, g.currentState);
 
-                    auto outcome = this->m_engine->getGameResult(
-                        g.currentState, g.hashHistory);
+                    stepHashes.emplace_back(g.hashHistory);
+                }
+
+                stepResults.resize(steps.size());
+                this->m_engine->getGameResultBatch(stepStates, stepHashes, stepResults);
+
+                uint32_t liveCount = activeCount;
+                for (size_t i = 0; i < steps.size(); ++i)
+                {
+                    GameContext& g = *steps[i].game;
+                    auto& outcome = stepResults[i];
 
                     if (!outcome
                         && g.turnCount > this->m_engineCfg.resignMinPly
-                        && resignQ < this->m_engineCfg.resignThreshold)
+                        && steps[i].resignQ < this->m_engineCfg.resignThreshold)
                     {
-                        outcome = this->m_engine->buildResignResult(cp);
+                        outcome = this->m_engine->buildResignResult(steps[i].player);
                     }
 
                     if (outcome)
                     {
-                        if (g.isOfficial && dash.gamesWritten < target)
+                        if (g.isOfficial && wantGames())
                         {
                             dash.gamesEnded++;
                             const size_t samples = g.replayBuffer.size();
@@ -492,16 +818,67 @@ namespace Core
                             }
                         }
 
-                        resetGame(g);
-                        g.isOfficial = (dash.gamesWritten < target);
+                        // Over target: park at the game boundary instead of starting anew.
+                        if (liveCount > cc.target) {
+                            parkGame(g);
+                            --liveCount;
+                        }
+                        else {
+                            resetGame(g);
+                            g.isOfficial = wantGames();
+                        }
+                    }
+                }
+
+                {
+                    size_t workingSet = 0;
+                    for (const auto& g : games)
+                        if (g.isActive) workingSet += gameWorkingSet(g);
+                    cc.update(this->m_threadPool->getPipelineStats(), workingSet, m_backendCfg, numInferWorkers);
+                }
+
+                if (continuous && !readyMarked && dash.gamesWritten >= target) {
+                    markDatasetReady(outFile);
+                    readyMarked = true;
+                }
+
+                // Hot-swap: the model loads off the main thread; once it is ready the
+                // ThreadPool switches over between batches and the dataset rotates.
+                if (continuous && !pendingLoad.valid()) {
+                    if (watcher.poll()) pendingLoad = std::async(std::launch::async, m_backendLoader);
+                }
+                else if (continuous && pendingLoad.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                    bool swapped = false;
+                    try {
+                        this->m_threadPool->swapBackends(pendingLoad.get());
+                        swapped = true;
+                    }
+                    catch (const std::exception& e) {
+                        std::cerr << "\n[SelfPlayHandler] Model reload failed, keeping the current model: " << e.what() << "\n";
                     }
+
+                    if (swapped) {
+                        const double iterTime = std::chrono::duration<double>(
+                            std::chrono::high_resolution_clock::now() - startTime).count();
+                        printSummary(dash, target, iterTime, m_datasetPath);
+                        rotateDataset(outFile);
+                        std::cout << "[SelfPlayHandler] Model reloaded from " << m_modelFile
+                            << " -> " << m_datasetPath << "\n";
+
+                        dash = DashboardState{};
+                        startTime = std::chrono::high_resolution_clock::now();
+                        readyMarked = false;
+                    }
+                    dash.firstDraw = true;
                 }
 
                 const double elapsed = std::chrono::duration<double>(
                     std::chrono::high_resolution_clock::now() - startTime).count();
-                printDashboard(dash, target, elapsed, snap);
+                printDashboard(dash, target, elapsed, snap, cc);
             }
 
+            this->m_threadPool->setRoleChangeEcho(true);
+
             if (!g_keepRunning.load(std::memory_order_acquire))
                 std::cout << "\n[System] Interrupted — flushing buffers...\n";
 
@@ -4,6 +4,7 @@
 #include "../util/PovUtils.hpp"
 #include "../util/Zobrist.hpp"
 #include <optional>
+#include <type_traits>
 
 namespace Core
 {
@@ -45,6 +46,8 @@ namespace Core
 
         // Generates the strict set of legal moves. Core bottleneck of the engine; 
         // must be heavily optimized (e.g., using bitboards).
+        // Each move is pushed with its policy index (= actionToIdx of that move);
+        // the search reads those instead of calling actionToIdx.
         virtual ActionList getValidActions(const State& state, std::span<const uint64_t> hashHistory) const = 0;
 
         // Validates a specific move. Used primarily to sanitize external/human input.
@@ -74,5 +77,53 @@ namespace Core
         // Defines the bijection between the engine's structured Action representation 
         // and the Neural Network's flat 1D policy output tensor.
         [[nodiscard]] virtual uint32_t actionToIdx(const Action& action) const = 0;
+
+        // --- 5. BATCH ENTRY POINTS ---
+
+        // Same contracts as above, over many independent states at once (e.g. every
+        // self-play game advancing by one ply, or the MCTS leaves one gather pass
+        // claimed). Entry i of each span belongs to state i.
+        // The defaults loop over the single-state calls; engines override them to
+        // amortize per-state setup and keep one code path hot across the batch.
+        virtual void getValidActionsBatch(std::span<const State* const> states,
+            std::span<const std::span<const uint64_t>> hashHistories, std::span<ActionList> outActions) const
+        {
+            for (size_t i = 0; i < states.size(); ++i)
+                outActions[i] = getValidActions(*states[i], hashHistories[i]);
+        }
+
+        virtual void applyActionBatch(std::span<const Action> actions, std::span<State* const> outStates) const
+        {
+            for (size_t i = 0; i < outStates.size(); ++i)
+                applyAction(actions[i], *outStates[i]);
+        }
+
+        virtual void getGameResultBatch(std::span<const State* const> states,
+            std::span<const std::span<const uint64_t>> hashHistories,
+            std::span<std::optional<GameResult>> outResults) const
+        {
+            for (size_t i = 0; i < states.size(); ++i)
+                outResults[i] = getGameResult(*states[i], hashHistories[i]);
+        }
     };
+
+    // ============================================================================
+    // STATIC ENGINE BINDING
+    // Engine type the search core (TreeSearch, ThreadPool) calls into.
+    //
+    // Design Intent:
+    // When the traits name their concrete engine ('using Engine = ...'), the core
+    // holds that type instead of IEngine<GT>. Declared 'final', every rule call in
+    // the MCTS loop then resolves to a direct (inlinable) call instead of a vtable
+    // dispatch. Traits without an Engine keep the virtual interface, which also
+    // remains the only type handlers and the bootstrapper see.
+    // ============================================================================
+    template<typename GT, typename = void>
+    struct BoundEngine { using type = IEngine<GT>; };
+
+    template<typename GT>
+    struct BoundEngine<GT, std::void_t<typename GT::Engine>> { using type = typename GT::Engine; };
+
+    template<typename GT>
+    using BoundEngineT = typename BoundEngine<GT>::type;
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <array>
+#include <span>
+
+#include "../bootstrap/GameConfig.hpp"
+#include "../model/GameTypes.hpp"
+
+namespace Core
+{
+    // ============================================================================
+    // HEURISTIC EVALUATOR INTERFACE
+    // Optional, game-provided leaf evaluator used instead of the neural network
+    // (backend.inferenceBackend: heuristic, or the first heuristicIterations of
+    // a training run).
+    //
+    // Design Intent:
+    // Runs inline on the search threads: the leaf never enters the inference
+    // queue, so throughput is bounded by CPU search speed alone. Outputs use the
+    // network's conventions so the rest of the pipeline cannot tell them apart:
+    //   - wdl: [W, D, L] per player, slot 0 = the side to move (viewer).
+    //   - actionLogits: one raw logit per entry of validActions (same order);
+    //     the caller applies the softmax and stores them as child priors.
+    // Must be stateless after setup() (called concurrently from every thread).
+    // ============================================================================
+    template<ValidGameTraits GT>
+    class IEvaluator
+    {
+    public:
+        USING_GAME_TYPES(GT);
+
+    protected:
+        virtual void specificSetup(const YAML::Node& config) = 0;
+
+    public:
+        virtual ~IEvaluator() = default;
+
+        void setup(const YAML::Node& config) { specificSetup(config); }
+
+        virtual void evaluate(const State& state, uint32_t viewer, const ActionList& validActions,
+            std::array<float, Defs::kNumPlayers * 3>& wdl, std::span<float> actionLogits) const = 0;
+    };
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include "../model/GameTypes.hpp"
+#include "../util/AlignedVec.hpp"
+
+namespace Core
+{
+    // ========================================================================
+    // MODEL RESULTS
+    //
+    // Values: Stores exactly 3 probabilities (Win, Draw, Loss) per player.
+    // Maps identically to the GameResult::wdl schema.
+    // Policy: Row of kActionSpace raw logits inside the backend's slot output
+    // buffer (no copy). Valid until the slot is submitted again; the ThreadPool
+    // gathers the legal-move entries and applies the softmax before that.
+    // ========================================================================
+    template<ValidGameTraits GT>
+    struct ModelResultsT
+    {
+        USING_GAME_TYPES(GT);
+
+        std::array<float, Defs::kNumPlayers * 3> values{};  // WDL per player
+        const float*                             policy = nullptr;  // Raw policy logits
+
+        ModelResultsT() noexcept = default;
+    };
+
+    // Row format of inputBuffer(): StateEncoder::encode (kNNInputSize floats) or
+    // StateEncoder::encodePacked (kPackedInputSize floats).
+    enum class InputLayout : uint8_t
+    {
+        Dense,
+        Packed
+    };
+
+    // ========================================================================
+    // INFERENCE BACKEND INTERFACE
+    // Evaluates batches of encoded states for the ThreadPool inference stage.
+    //
+    // Architecture:
+    // One backend instance may be driven by several inference threads; each
+    // implementation is responsible for its own internal synchronization.
+    // bindThread() runs once on every thread that will drive the backend
+    // (e.g. to select a CUDA device).
+    //
+    // Batch Slots:
+    // A backend exposes numSlots() independent staging areas so several
+    // batches can be in flight at once. The caller encodes leaves straight into
+    // inputBuffer(slot) (maxBatch() rows of inputRowSize() floats, no further
+    // copy), submit() launches the first 'count' rows without waiting for them,
+    // ready() polls for completion and collect() blocks until the results are
+    // written. A slot is owned by one thread at a time and its ResultBatch must
+    // stay alive until collect() returns. Synchronous backends may compute
+    // inside submit() and keep the ready()/collect() defaults.
+    // ========================================================================
+    template<ValidGameTraits GT>
+    class IInferenceBackend
+    {
+    public:
+        USING_GAME_TYPES(GT);
+        using ResultBatch = AlignedVec<ModelResultsT<GT>>;
+
+        virtual ~IInferenceBackend() = default;
+
+        [[nodiscard]] virtual uint32_t         maxBatch() const noexcept = 0;
+        [[nodiscard]] virtual uint32_t         numSlots() const noexcept = 0;
+        [[nodiscard]] virtual std::string_view name() const noexcept = 0;
+
+        // Returns false if the calling thread cannot drive this backend.
+        virtual bool bindThread() { return true; }
+
+        [[nodiscard]] virtual float* inputBuffer(uint32_t slot) noexcept = 0;
+        [[nodiscard]] virtual InputLayout inputLayout() const noexcept { return InputLayout::Dense; }
+
+        [[nodiscard]] uint32_t inputRowSize() const noexcept {
+            return inputLayout() == InputLayout::Packed ? Defs::kPackedInputSize : Defs::kNNInputSize;
+        }
+
+        // results is resized to at least count. count <= maxBatch().
+        virtual void submit(uint32_t slot, uint32_t count, ResultBatch& results) = 0;
+        [[nodiscard]] virtual bool ready(uint32_t /*slot*/) { return true; }
+        virtual void collect(uint32_t /*slot*/) {}
+    };
+}
@@ -24,7 +24,8 @@ int main(int argc, char* argv[])
         std::cerr << "Usage: " << argv[0] << " <config.yaml> [options]\n"
             << "Options:\n"
             << "  --mode <play|train|export-meta>  Set the execution mode (default: play)\n"
-            << "  --model <model_file.plan> [REQUIRED] Set the TensorRT model file name\n"
+            << "  --model <model_file.plan> [REQUIRED] Set the model file name (.plan for TensorRT,\n"
+            << "                                      the sibling .weights file is used by the CPU backend)\n"
             << std::endl;
         return EXIT_FAILURE;
     }
@@ -140,5 +140,24 @@ namespace Core
             m_cv_push.notify_one();
             return true;
         }
+
+        // Single-item pop with a deadline. Returns false on timeout as well as on
+        // closure, letting workers re-check external state (e.g. a role change)
+        // instead of parking indefinitely on one queue.
+        bool pop_for(T& out, std::chrono::microseconds timeout)
+        {
+            std::unique_lock lock(m_mutex);
+            if (!m_cv_pop.wait_for(lock, timeout, [this] { return m_count > 0 || m_closed; }))
+                return false;
+            if (m_closed && (m_count == 0 || m_fastDrain)) return false;
+
+            out = m_buffer[m_head];
+            m_head = (m_head + 1) & m_mask;
+            m_count.fetch_sub(1, std::memory_order_release);
+
+            lock.unlock();
+            m_cv_push.notify_one();
+            return true;
+        }
     };
 }
\ No newline at end of file
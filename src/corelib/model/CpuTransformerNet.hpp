@@ -0,0 +1,298 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+
+#include "../bootstrap/GameConfig.hpp"
+#include "../interfaces/IInferenceBackend.hpp"
+#include "../util/AlignedVec.hpp"
+#include "../util/DenseOps.hpp"
+#include "../util/WorkerTeam.hpp"
+
+namespace Core
+{
+    // ========================================================================
+    // CPU TRANSFORMER BACKEND
+    // Pure fp32 re-implementation of OneMindArmyNet (scripts/train.py) for
+    // hosts without CUDA/TensorRT: CI, benchmarks, CPU-only builds.
+    //
+    // Weights File (written by train.py::export_cpu_weights, little-endian):
+    //   char[4] "OMAW" | u32 version | u32 tokenDim, seqLen, dModel, nHeads,
+    //   nLayers, dimFeedforward, actionSpace, numPlayers
+    //   followed by fp32 tensors in PyTorch layout ([out, in] for Linear):
+    //     embedding.{weight,bias}, pos_encoder
+    //     per layer: self_attn.in_proj_{weight,bias}, self_attn.out_proj.{weight,bias},
+    //                linear1.{weight,bias}, linear2.{weight,bias},
+    //                norm1.{weight,bias}, norm2.{weight,bias}
+    //     policy_head.{0,2}.{weight,bias}, value_head.{0,2}.{weight,bias}
+    //
+    // Execution:
+    // The whole batch is flattened to [B*S, d] rows. Linear layers are tiled
+    // (rows x output columns) and attention is split per (sample, head), all
+    // scheduled on a persistent WorkerTeam. Outputs mirror the ONNX export:
+    // raw policy logits and per-player softmaxed WDL.
+    // ========================================================================
+    template<ValidGameTraits GT>
+    class CpuTransformerNet final : public IInferenceBackend<GT>
+    {
+    private:
+        USING_GAME_TYPES(GT);
+        using typename IInferenceBackend<GT>::ResultBatch;
+
+        static constexpr uint32_t kVersion = 1;
+        static constexpr uint32_t kValueHidden = 64;
+        static constexpr size_t   kRowTile = 16;
+        static constexpr size_t   kColTile = 64;
+
+        struct FileHeader
+        {
+            char     magic[4];
+            uint32_t version;
+            uint32_t tokenDim, seqLen, dModel, nHeads, nLayers, dimFF, actionSpace, numPlayers;
+        };
+
+        struct LayerWeights
+        {
+            const float* inW;  const float* inB;
+            const float* outW; const float* outB;
+            const float* ff1W; const float* ff1B;
+            const float* ff2W; const float* ff2B;
+            const float* n1G;  const float* n1B;
+            const float* n2G;  const float* n2B;
+        };
+
+        size_t m_tokenDim = 0, m_seq = 0, m_d = 0, m_heads = 0, m_headDim = 0, m_ff = 0;
+
+        AlignedVec<float>         m_blob;
+        const float*              m_embW = nullptr;
+        const float*              m_embB = nullptr;
+        const float*              m_pos = nullptr;
+        std::vector<LayerWeights> m_layers;
+        const float*              m_p0W = nullptr; const float* m_p0B = nullptr;
+        const float*              m_p2W = nullptr; const float* m_p2B = nullptr;
+        const float*              m_v0W = nullptr; const float* m_v0B = nullptr;
+        const float*              m_v2W = nullptr; const float* m_v2B = nullptr;
+
+        uint32_t   m_maxBatch;
+        WorkerTeam m_team;
+        std::mutex m_forwardMutex; // Scratch buffers and the team are shared by all callers
+
+        AlignedVec<AlignedVec<float>> m_inputs;   // One [maxBatch x kNNInputSize] buffer per slot
+        AlignedVec<AlignedVec<float>> m_policies; // One [maxBatch x kActionSpace] logits buffer per slot
+        AlignedVec<float> m_x, m_qkv, m_attn, m_tmp, m_hidden, m_scores;
+        AlignedVec<float> m_pooled, m_headHidden, m_valueLogits;
+
+        void loadWeights(const std::string& path, const NetworkConfig& netCfg)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open())
+                throw std::runtime_error("CpuTransformerNet: cannot open weights: " + path);
+
+            FileHeader h{};
+            file.read(reinterpret_cast<char*>(&h), sizeof(h));
+            if (!file || std::memcmp(h.magic, "OMAW", 4) != 0)
+                throw std::runtime_error("CpuTransformerNet: not an OMAW weights file: " + path);
+            if (h.version != kVersion)
+                throw std::runtime_error("CpuTransformerNet: unsupported weights version in " + path);
+
+            if (h.tokenDim != Defs::kTokenDim || h.tokenDim * h.seqLen != Defs::kNNInputSize
+                || h.actionSpace != Defs::kActionSpace
+                || h.numPlayers != Defs::kNumPlayers)
+                throw std::runtime_error("CpuTransformerNet: weights do not match the compiled game dimensions.");
+
+            if (h.dModel == 0 || h.nHeads == 0 || h.dModel % h.nHeads != 0)
+                throw std::runtime_error("CpuTransformerNet: dModel must be a multiple of nHeads.");
+
+            // The YAML 'network' block is authoritative when present.
+            if (netCfg.dModel != 0 && (netCfg.dModel != h.dModel || netCfg.nHeads != h.nHeads
+                || netCfg.nLayers != h.nLayers || netCfg.dimFeedforward != h.dimFF))
+                throw std::runtime_error("Config Error: 'network' dimensions do not match weights file " + path);
+
+            m_tokenDim = h.tokenDim; m_seq = h.seqLen; m_d = h.dModel;
+            m_heads = h.nHeads; m_headDim = m_d / m_heads; m_ff = h.dimFF;
+
+            const size_t d = m_d, A = h.actionSpace, V = size_t(h.numPlayers) * 3;
+            const size_t perLayer = 3 * d * d + 3 * d + d * d + d + m_ff * d + m_ff + d * m_ff + d + 4 * d;
+            const size_t total = d * m_tokenDim + d + m_seq * d + h.nLayers * perLayer
+                + d * d + d + A * d + A + kValueHidden * d + kValueHidden + V * kValueHidden + V;
+
+            m_blob.resize(total);
+            file.read(reinterpret_cast<char*>(m_blob.data()), static_cast<std::streamsize>(total * sizeof(float)));
+            if (static_cast<size_t>(file.gcount()) != total * sizeof(float) || file.peek() != std::char_traits<char>::eof())
+                throw std::runtime_error("CpuTransformerNet: weights file size mismatch: " + path);
+
+            const float* p = m_blob.data();
+            auto take = [&p](size_t n) { const float* t = p; p += n; return t; };
+
+            m_embW = take(d * m_tokenDim); m_embB = take(d);
+            m_pos = take(m_seq * d);
+
+            m_layers.resize(h.nLayers);
+            for (auto& L : m_layers) {
+                L.inW = take(3 * d * d); L.inB = take(3 * d);
+                L.outW = take(d * d);    L.outB = take(d);
+                L.ff1W = take(m_ff * d); L.ff1B = take(m_ff);
+                L.ff2W = take(d * m_ff); L.ff2B = take(d);
+                L.n1G = take(d); L.n1B = take(d);
+                L.n2G = take(d); L.n2B = take(d);
+            }
+
+            m_p0W = take(d * d); m_p0B = take(d);
+            m_p2W = take(A * d); m_p2B = take(A);
+            m_v0W = take(kValueHidden * d); m_v0B = take(kValueHidden);
+            m_v2W = take(V * kValueHidden); m_v2B = take(V);
+        }
+
+        void linear(const float* X, size_t rows, size_t in, const float* W, const float* bias,
+            size_t out, float* Y, bool relu)
+        {
+            const size_t rowTiles = (rows + kRowTile - 1) / kRowTile;
+            const size_t colTiles = (out + kColTile - 1) / kColTile;
+            m_team.parallelFor(rowTiles * colTiles, [&](size_t t) {
+                const size_t r0 = (t / colTiles) * kRowTile, c0 = (t % colTiles) * kColTile;
+                DenseOps::linearTile(X, in, W, bias, out, Y,
+                    r0, std::min(rows, r0 + kRowTile), c0, std::min(out, c0 + kColTile), relu);
+                });
+        }
+
+        // Multi-head self-attention over m_qkv ([R, 3d] = Q | K | V) into m_attn ([R, d]).
+        void attention(size_t batch)
+        {
+            const size_t d = m_d, S = m_seq, dh = m_headDim;
+            const float scale = 1.0f / std::sqrt(static_cast<float>(dh));
+
+            m_team.parallelFor(batch * m_heads, [&](size_t t) {
+                const size_t b = t / m_heads, h = t % m_heads;
+                const float* base = m_qkv.data() + b * S * 3 * d;
+                float* scores = m_scores.data() + t * S;
+
+                for (size_t i = 0; i < S; ++i) {
+                    const float* q = base + i * 3 * d + h * dh;
+                    for (size_t j = 0; j < S; ++j)
+                        scores[j] = DenseOps::dot(q, base + j * 3 * d + d + h * dh, dh) * scale;
+                    DenseOps::softmax(scores, S);
+
+                    float* o = m_attn.data() + (b * S + i) * d + h * dh;
+                    std::fill(o, o + dh, 0.0f);
+                    for (size_t j = 0; j < S; ++j)
+                        DenseOps::axpy(o, base + j * 3 * d + 2 * d + h * dh, scores[j], dh);
+                }
+                });
+        }
+
+        void addNormRows(size_t rows, const float* gamma, const float* beta)
+        {
+            const size_t tiles = (rows + kRowTile - 1) / kRowTile;
+            m_team.parallelFor(tiles, [&](size_t t) {
+                const size_t r1 = std::min(rows, (t + 1) * kRowTile);
+                for (size_t r = t * kRowTile; r < r1; ++r)
+                    DenseOps::addLayerNorm(m_x.data() + r * m_d, m_tmp.data() + r * m_d, gamma, beta, m_d);
+                });
+        }
+
+    public:
+        CpuTransformerNet(const std::string& weightsPath, const NetworkConfig& netCfg,
+            uint32_t maxBatch, uint32_t numThreads, uint32_t numSlots = 1)
+            : m_maxBatch(maxBatch)
+            , m_team(numThreads ? numThreads : std::max(1u, std::thread::hardware_concurrency()))
+            , m_inputs(std::max(1u, numSlots))
+            , m_policies(std::max(1u, numSlots))
+        {
+            loadWeights(weightsPath, netCfg);
+
+            for (auto& in : m_inputs) in.resize(static_cast<size_t>(maxBatch) * Defs::kNNInputSize);
+            for (auto& pol : m_policies) pol.resize(static_cast<size_t>(maxBatch) * Defs::kActionSpace);
+
+            const size_t R = static_cast<size_t>(maxBatch) * m_seq;
+            m_x.resize(R * m_d);
+            m_qkv.resize(R * 3 * m_d);
+            m_attn.resize(R * m_d);
+            m_tmp.resize(R * m_d);
+            m_hidden.resize(R * m_ff);
+            m_scores.resize(static_cast<size_t>(maxBatch) * m_heads * m_seq);
+            m_pooled.resize(static_cast<size_t>(maxBatch) * m_d);
+            m_headHidden.resize(static_cast<size_t>(maxBatch) * m_d);
+            m_valueLogits.resize(static_cast<size_t>(maxBatch) * Defs::kNumPlayers * 3);
+
+            std::cout << "[CpuTransformerNet] Loaded " << weightsPath << " (d=" << m_d << ", heads=" << m_heads
+                << ", layers=" << m_layers.size() << ", ff=" << m_ff << ", threads=" << m_team.size() << ")\n";
+        }
+
+        CpuTransformerNet(const CpuTransformerNet&) = delete;
+        CpuTransformerNet& operator=(const CpuTransformerNet&) = delete;
+
+        [[nodiscard]] uint32_t         maxBatch() const noexcept override { return m_maxBatch; }
+        [[nodiscard]] uint32_t         numSlots() const noexcept override { return static_cast<uint32_t>(m_inputs.size()); }
+        [[nodiscard]] std::string_view name() const noexcept override { return "cpu"; }
+
+        [[nodiscard]] float* inputBuffer(uint32_t slot) noexcept override { return m_inputs[slot].data(); }
+
+        // Computes synchronously: results are final when submit() returns.
+        void submit(uint32_t slot, uint32_t count, ResultBatch& results) override
+        {
+            const size_t B = count;
+            if (B == 0) return;
+            if (B > m_maxBatch)
+                throw std::runtime_error("CpuTransformerNet: batch exceeds maxBatch.");
+            if (results.size() < B) results.resize(B);
+
+            std::lock_guard lock(m_forwardMutex);
+
+            const size_t S = m_seq, d = m_d, R = B * S;
+            constexpr size_t V = Defs::kNumPlayers * 3;
+
+            // 1. Token embedding + learned positional encoding (rows read in place)
+            linear(m_inputs[slot].data(), R, m_tokenDim, m_embW, m_embB, d, m_x.data(), false);
+            for (size_t r = 0; r < R; ++r)
+                DenseOps::axpy(m_x.data() + r * d, m_pos + (r % S) * d, 1.0f, d);
+
+            // 2. Post-norm encoder layers
+            for (const auto& L : m_layers) {
+                linear(m_x.data(), R, d, L.inW, L.inB, 3 * d, m_qkv.data(), false);
+                attention(B);
+                linear(m_attn.data(), R, d, L.outW, L.outB, d, m_tmp.data(), false);
+                addNormRows(R, L.n1G, L.n1B);
+
+                linear(m_x.data(), R, d, L.ff1W, L.ff1B, m_ff, m_hidden.data(), true);
+                linear(m_hidden.data(), R, m_ff, L.ff2W, L.ff2B, d, m_tmp.data(), false);
+                addNormRows(R, L.n2G, L.n2B);
+            }
+
+            // 3. Mean pooling over the sequence
+            const float invS = 1.0f / static_cast<float>(S);
+            for (size_t b = 0; b < B; ++b) {
+                float* pooled = m_pooled.data() + b * d;
+                std::fill(pooled, pooled + d, 0.0f);
+                for (size_t s = 0; s < S; ++s)
+                    DenseOps::axpy(pooled, m_x.data() + (b * S + s) * d, invS, d);
+            }
+
+            // 4. Heads
+            linear(m_pooled.data(), B, d, m_p0W, m_p0B, d, m_headHidden.data(), true);
+            float* policyLogits = m_policies[slot].data();
+            linear(m_headHidden.data(), B, d, m_p2W, m_p2B, Defs::kActionSpace, policyLogits, false);
+
+            linear(m_pooled.data(), B, d, m_v0W, m_v0B, kValueHidden, m_headHidden.data(), true);
+            linear(m_headHidden.data(), B, kValueHidden, m_v2W, m_v2B, V, m_valueLogits.data(), false);
+
+            for (size_t b = 0; b < B; ++b) {
+                auto& res = results[b];
+                res.policy = policyLogits + b * Defs::kActionSpace;
+
+                float* v = m_valueLogits.data() + b * V;
+                for (size_t p = 0; p < Defs::kNumPlayers; ++p) DenseOps::softmax(v + p * 3, 3);
+                std::memcpy(res.values.data(), v, V * sizeof(float));
+            }
+        }
+    };
+}
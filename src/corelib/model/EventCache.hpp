@@ -0,0 +1,135 @@
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <array>
+#include <algorithm>
+
+#include "../util/AlignedVec.hpp"
+
+namespace Core
+{
+    // ========================================================================
+    // EVENT RESERVOIR
+    // Global backing store for recycled evaluation contexts.
+    //
+    // Design Intent:
+    // Workers never visit the reservoir per simulation. They exchange whole
+    // batches with it through their LocalEventCache, amortizing one lock
+    // round-trip over many acquire/release pairs. Storage is a LIFO stack so
+    // the most recently returned (cache-warm) contexts are handed out first.
+    // ========================================================================
+    template<typename T>
+    class EventReservoir
+    {
+        AlignedVec<T*>          m_items;
+        std::atomic<size_t>     m_count{ 0 };
+        std::mutex              m_mutex;
+        std::condition_variable m_cv;
+        bool                    m_closed = false;
+
+    public:
+        // Capacity must cover every context that can ever be returned.
+        explicit EventReservoir(size_t capacity)
+            : m_items(reserve_only, capacity)
+        {
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return m_count.load(std::memory_order_relaxed); }
+
+        void close()
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_closed = true;
+            }
+            m_cv.notify_all();
+        }
+
+        // Never blocks: the reservoir is sized for the whole pool.
+        void putBulk(T* const* items, size_t n)
+        {
+            if (n == 0) return;
+            {
+                std::lock_guard lock(m_mutex);
+                m_items.insert(m_items.end(), items, items + n);
+                m_count.store(m_items.size(), std::memory_order_relaxed);
+            }
+            m_cv.notify_all();
+        }
+
+        // Blocks until at least one context is available. Returns 0 once closed.
+        size_t takeBulk(T** out, size_t maxItems)
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this] { return !m_items.empty() || m_closed; });
+            if (m_closed) return 0;
+
+            const size_t n = std::min(maxItems, m_items.size());
+            const size_t base = m_items.size() - n;
+            for (size_t i = 0; i < n; ++i) out[i] = m_items[base + i];
+            m_items.resize(base);
+            m_count.store(base, std::memory_order_relaxed);
+            return n;
+        }
+    };
+
+    // ========================================================================
+    // LOCAL EVENT CACHE
+    // Worker-owned free list in front of the EventReservoir.
+    //
+    // Gather workers only acquire and backprop workers only release, so the
+    // caches drift in opposite directions; half-capacity bulk transfers keep
+    // both sides on the lock-free path for Capacity/2 operations at a time.
+    // A cache can strand at most Capacity contexts, which the owning pool
+    // must provision as headroom.
+    // ========================================================================
+    template<typename T, size_t Capacity = 32>
+    class LocalEventCache
+    {
+        static_assert(Capacity >= 2 && Capacity % 2 == 0, "Capacity must be even.");
+        static constexpr size_t kTransfer = Capacity / 2;
+
+        EventReservoir<T>&       m_reservoir;
+        std::array<T*, Capacity> m_items{};
+        size_t                   m_count = 0;
+
+    public:
+        static constexpr size_t kCapacity = Capacity;
+
+        explicit LocalEventCache(EventReservoir<T>& reservoir) : m_reservoir(reservoir) {}
+        ~LocalEventCache() { flush(); }
+
+        LocalEventCache(const LocalEventCache&) = delete;
+        LocalEventCache& operator=(const LocalEventCache&) = delete;
+
+        // Returns false only when the reservoir has been closed.
+        bool acquire(T*& out)
+        {
+            if (m_count == 0) {
+                m_count = m_reservoir.takeBulk(m_items.data(), kTransfer);
+                if (m_count == 0) return false;
+            }
+            out = m_items[--m_count];
+            return true;
+        }
+
+        void release(T* item)
+        {
+            if (m_count == Capacity) {
+                // Hand back the oldest (coldest) half, keep the warm top locally.
+                m_reservoir.putBulk(m_items.data(), kTransfer);
+                std::copy(m_items.begin() + kTransfer, m_items.end(), m_items.begin());
+                m_count -= kTransfer;
+            }
+            m_items[m_count++] = item;
+        }
+
+        void flush()
+        {
+            m_reservoir.putBulk(m_items.data(), m_count);
+            m_count = 0;
+        }
+    };
+}
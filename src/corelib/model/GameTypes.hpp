@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <array>
+#include <algorithm>
 #include <cstdint>
 #include <cstddef>
 #include <limits>
@@ -68,6 +69,29 @@ namespace Core
     using SelectMinimalUIntT = typename SelectMinimalUInt<MaxValue>::type;
 
 
+    // ========================================================================
+    // 128-BIT POSITION KEY
+    // Two independent 64-bit Zobrist streams. 'lo' is the classic key (the one
+    // State::hash() returns); 'hi' only exists to make collisions negligible
+    // when positions are shared by hash across many games (caches, tables).
+    // ========================================================================
+    struct Hash128
+    {
+        uint64_t lo = 0;
+        uint64_t hi = 0;
+
+        constexpr Hash128& operator^=(const Hash128& other) noexcept
+        {
+            lo ^= other.lo;
+            hi ^= other.hi;
+            return *this;
+        }
+
+        [[nodiscard]] friend constexpr Hash128 operator^(Hash128 a, const Hash128& b) noexcept { return a ^= b; }
+        [[nodiscard]] friend constexpr bool operator==(const Hash128&, const Hash128&) noexcept = default;
+    };
+
+
     // ========================================================================
     // ADAPTIVE SPATIAL BITSET
     // Universal representation of board geometry. 
@@ -137,6 +161,30 @@ namespace Core
             for (size_t i = start; i <= end; ++i) unset(i);
         }
 
+        [[nodiscard]] constexpr bool operator==(const BitsetT&) const noexcept = default;
+
+        // Bits [8i, 8i + 8) as a byte (0 past the end).
+        [[nodiscard]] constexpr uint8_t byte(size_t i) const noexcept
+        {
+            if constexpr (Props::IsPrimitive) return (i < sizeof(Storage)) ? static_cast<uint8_t>(bits >> (8 * i)) : 0;
+            else return (i / 8 < Props::kNumWords) ? static_cast<uint8_t>(bits[i / 8] >> (8 * (i % 8))) : 0;
+        }
+
+        // Calls f(pos) for every set bit, in ascending order.
+        template<typename F>
+        constexpr void forEachSet(F&& f) const
+        {
+            if constexpr (Props::IsPrimitive) {
+                for (Storage b = bits; b; b &= static_cast<Storage>(b - 1))
+                    f(static_cast<size_t>(std::countr_zero(b)));
+            }
+            else {
+                for (size_t w = 0; w < Props::kNumWords; ++w)
+                    for (uint64_t b = bits[w]; b; b &= b - 1)
+                        f(w * 64 + static_cast<size_t>(std::countr_zero(b)));
+            }
+        }
+
         [[nodiscard]] constexpr int popcount() const noexcept
         {
             if constexpr (Props::IsPrimitive) return std::popcount(bits);
@@ -196,8 +244,23 @@ namespace Core
         static constexpr uint32_t kNNSequenceLength = kMaxFacts + kMaxHistory;
         static constexpr uint32_t kNNInputSize = kNNSequenceLength * kTokenDim;
 
+        // Packed input layout (see StateEncoder::encodePacked): the multi-hot mask
+        // becomes 8-bit words, each stored as an integral float (exact in fp16).
+        static constexpr uint32_t kPosBitsPerWord = 8;
+        static constexpr uint32_t kPosWords = std::max<uint32_t>(2, (kNumPos + kPosBitsPerWord - 1) / kPosBitsPerWord);
+        static constexpr uint32_t kPackedTokenDim = 4 + kPosWords;
+        static constexpr uint32_t kPackedInputSize = kNNSequenceLength * kPackedTokenDim;
+
         static constexpr uint32_t kActionSpace = GT::kActionSpace;
 
+        // Optional trait 'static constexpr bool kWideHash = true;': States then
+        // carry a second Zobrist stream and expose a 128-bit key (hash128()).
+        static constexpr bool kWideHash = [] {
+            if constexpr (requires { GT::kWideHash; }) return static_cast<bool>(GT::kWideHash);
+            else return false;
+        }();
+        using HashT = std::conditional_t<kWideHash, Hash128, uint64_t>;
+
         // Sentinel bounds indicating inactive or unowned states.
         static constexpr uint32_t kPadFact = kNumFactTypes;
         static constexpr uint32_t kNoOwner = kNumPlayers;
@@ -322,6 +385,13 @@ namespace Core
             m_location.set(loc);
         }
 
+        // Whole-mask assignment (e.g. a transformed location); marks the fact present.
+        void setLocation(const LocType& loc) noexcept
+        {
+            this->m_value = 1.0f;
+            m_location = loc;
+        }
+
         // Probability cloud expansion (Imperfect info)
         void addPossiblePos(uint32_t loc) noexcept
         {
@@ -428,29 +498,60 @@ namespace Core
         }
     };
 
+    // ========================================================================
+    // STATE EXTENSION BLOCK
+    // Optional engine-private data carried inside every State, declared by the
+    // traits as 'using StateExt = ...' (e.g. bitboards for a chess engine).
+    //
+    // Design Intent:
+    // Kept in sync by the same RAII proxy as the Zobrist hash: each fact's
+    // contribution is toggled out before a modification and back in after it,
+    // through Ext::toggle(factIdx, fact). Contributions must therefore be their
+    // own inverse (XOR), and a default-constructed Ext must match a cleared State.
+    // Games without an extension pay nothing (empty member, no-op toggle).
+    // ========================================================================
+    struct NoStateExt
+    {
+        template<typename F>
+        constexpr void toggle(uint32_t, const F&) noexcept {}
+    };
+
+    template<typename GT, typename = void>
+    struct StateExtOf { using type = NoStateExt; };
+
+    template<typename GT>
+    struct StateExtOf<GT, std::void_t<typename GT::StateExt>> { using type = typename GT::StateExt; };
+
     // ========================================================================
     // RAII ZOBRIST PROXY
     // Grants mutable access to a Fact while strictly guaranteeing that the 
-    // underlying State's Zobrist hash stays perfectly synchronized.
+    // underlying State's Zobrist hash (and extension block) stays perfectly synchronized.
     // XORs the fact out of the hash on creation, and XORs it back on destruction.
     // ========================================================================
     template<ValidGameTraits GT>
     class FactMutator
     {
     private:
-        uint64_t& m_stateHash;
+        using Ext = typename StateExtOf<GT>::type;
+        using HashT = typename GameDefs<GT>::HashT;
+
+        HashT& m_stateHash;
+        Ext& m_ext;
         Core::Fact<GT>& m_fact;
+        uint32_t m_factIdx;
 
     public:
-        FactMutator(uint64_t& hashRef, Core::Fact<GT>& f) noexcept
-            : m_stateHash(hashRef), m_fact(f)
+        FactMutator(HashT& hashRef, Ext& ext, Core::Fact<GT>& f, uint32_t factIdx) noexcept
+            : m_stateHash(hashRef), m_ext(ext), m_fact(f), m_factIdx(factIdx)
         {
             m_stateHash ^= Core::GenericZobrist<GT>::getKey(m_fact);
+            m_ext.toggle(m_factIdx, m_fact);
         }
 
         ~FactMutator() noexcept
         {
             m_stateHash ^= Core::GenericZobrist<GT>::getKey(m_fact);
+            m_ext.toggle(m_factIdx, m_fact);
         }
 
         FactMutator(const FactMutator&) = delete;
@@ -473,10 +574,13 @@ namespace Core
     public:
         using Defs = GameDefs<GT>;
         using FactType = typename Defs::FactType;
+        using Ext = typename StateExtOf<GT>::type;
+        using HashT = typename Defs::HashT;
 
     private:
         std::array<Core::Fact<GT>, Defs::kMaxFacts> m_facts;
-        uint64_t m_hash = 0;
+        HashT m_hash{};
+        [[no_unique_address]] Ext m_ext{};
 
         friend class PovUtils<GT>;
 
@@ -497,9 +601,22 @@ namespace Core
         void clear() noexcept
         {
             for (auto& f : m_facts) f.reset();
+            m_ext = Ext{};
+        }
+
+        // 64-bit key: cheap, and enough for repetition detection within a game.
+        [[nodiscard]] constexpr uint64_t hash() const noexcept
+        {
+            if constexpr (Defs::kWideHash) return m_hash.lo;
+            else                           return m_hash;
         }
 
-        [[nodiscard]] constexpr uint64_t hash() const noexcept { return m_hash; }
+        // 128-bit key for anything shared by hash across games (kWideHash games only).
+        [[nodiscard]] constexpr Hash128 hash128() const noexcept requires (Defs::kWideHash) { return m_hash; }
+
+        // Engine-private view maintained alongside the facts. Like hash(), it is
+        // not updated by PovUtils transforms (encoder-only copies).
+        [[nodiscard]] constexpr const Ext& ext() const noexcept { return m_ext; }
         [[nodiscard]] std::span<const Core::Fact<GT>> all() const noexcept { return m_facts; }
         [[nodiscard]] std::span<const Core::Fact<GT>> elems() const noexcept { return std::span<const Core::Fact<GT>>{ m_facts }.first(Defs::kMaxElems); }
         [[nodiscard]] std::span<const Core::Fact<GT>> metas() const noexcept { return std::span<const Core::Fact<GT>>{ m_facts }.subspan(Defs::kMaxElems, Defs::kMaxMetas); }
@@ -526,27 +643,44 @@ namespace Core
         [[nodiscard]] FactMutator<GT> modifyElem(uint32_t elemIdx) noexcept
         {
             assert(elemIdx < Defs::kMaxElems);
-            return FactMutator<GT>{m_hash, m_facts[elemIdx]};
+            return FactMutator<GT>{m_hash, m_ext, m_facts[elemIdx], elemIdx};
         }
 
         [[nodiscard]] FactMutator<GT> modifyMeta(uint32_t metaIdx) noexcept
         {
             assert(metaIdx < Defs::kMaxMetas);
-            return FactMutator<GT>{m_hash, m_facts[Defs::kMaxElems + metaIdx]};
+            return FactMutator<GT>{m_hash, m_ext, m_facts[Defs::kMaxElems + metaIdx], Defs::kMaxElems + metaIdx};
         }
 
         [[nodiscard]] FactMutator<GT> modifyFact(uint32_t factIdx) noexcept
         {
             assert(factIdx < Defs::kMaxFacts);
-            return FactMutator<GT>{m_hash, m_facts[factIdx]};
+            return FactMutator<GT>{m_hash, m_ext, m_facts[factIdx], factIdx};
         }
 
-        // Restores hash synchronization after bulk raw memory operations (e.g., FEN deserialization).
+        // Quiet relocation of a live, single-square element: the hash takes one
+        // Zobrist move delta instead of a key derivation before and after.
+        void moveElem(uint32_t elemIdx, uint32_t to) noexcept
+        {
+            assert(elemIdx < Defs::kMaxElems && to < Defs::kNumPos);
+            auto& f = m_facts[elemIdx];
+            const uint32_t from = f.pos();
+            assert(f.exists() && from != Defs::kNoPos);
+
+            m_hash ^= Core::GenericZobrist<GT>::moveKey(f.factId(), f.ownerId(), from, to);
+            m_ext.toggle(elemIdx, f);
+            f.setPos(to);
+            m_ext.toggle(elemIdx, f);
+        }
+
+        // Restores hash and extension synchronization after bulk raw memory operations (e.g., FEN deserialization).
         void recomputeHash() noexcept
         {
-            m_hash = 0;
-            for (const auto& f : m_facts) {
-                m_hash ^= Core::GenericZobrist<GT>::getKey(f);
+            m_hash = HashT{};
+            m_ext = Ext{};
+            for (uint32_t idx = 0; idx < Defs::kMaxFacts; ++idx) {
+                m_hash ^= Core::GenericZobrist<GT>::getKey(m_facts[idx]);
+                m_ext.toggle(idx, m_facts[idx]);
             }
         }
     };
@@ -592,6 +726,8 @@ namespace Core
 
         auto begin() noexcept { return m_data.begin(); }
         auto end() noexcept { return m_data.begin() + m_size; }
+        auto begin() const noexcept { return m_data.begin(); }
+        auto end() const noexcept { return m_data.begin() + m_size; }
 
         operator std::span<T>() noexcept { return std::span<T>(m_data.data(), m_size); }
         operator std::span<const T>() const noexcept { return std::span<const T>(m_data.data(), m_size); }
@@ -600,6 +736,47 @@ namespace Core
         T& operator[](size_t i) noexcept { return m_data[i]; }
     };
 
+    // ========================================================================
+    // LEGAL ACTION LIST
+    // StaticVec of actions carrying, for each entry, its policy index (the value
+    // IEngine::actionToIdx returns for it).
+    //
+    // Design Intent:
+    // The engine knows the index for free while generating a move (typically a
+    // table lookup on data already in registers), whereas mapping actions back
+    // afterwards costs a branchy decode per move, at every expansion. Filling
+    // both together lets the search read indices directly. The base is private
+    // and entries are read-only from outside: push_back takes the index along
+    // with the action, and nothing can reorder actions without their indices.
+    // ========================================================================
+    template<ValidGameTraits GT>
+    class ActionList : private StaticVec<Action<GT>, GameDefs<GT>::kMaxValidActions>
+    {
+    private:
+        using Base = StaticVec<Action<GT>, GameDefs<GT>::kMaxValidActions>;
+
+        static_assert(GameDefs<GT>::kActionSpace <= UINT16_MAX, "policy indices are stored as uint16_t");
+        std::array<uint16_t, GameDefs<GT>::kMaxValidActions> m_policyIdx;
+
+    public:
+        using Base::clear;
+        using Base::size;
+        using Base::empty;
+
+        void push_back(const Action<GT>& action, uint16_t policyIdx) noexcept {
+            m_policyIdx[this->size()] = policyIdx;
+            Base::push_back(action);
+        }
+
+        [[nodiscard]] const Action<GT>& operator[](size_t i) const noexcept { return Base::operator[](i); }
+        [[nodiscard]] auto begin() const noexcept { return Base::begin(); }
+        [[nodiscard]] auto end() const noexcept { return Base::end(); }
+        operator std::span<const Action<GT>>() const noexcept { return static_cast<const Base&>(*this); }
+
+        [[nodiscard]] uint16_t policyIdx(size_t i) const noexcept { return m_policyIdx[i]; }
+        [[nodiscard]] const uint16_t* policyIndices() const noexcept { return m_policyIdx.data(); }
+    };
+
     // ========================================================================
     // DEBUG & LOGGING
     // ========================================================================
@@ -641,7 +818,7 @@ namespace Core
     using Fact          = Core::Fact<GT>;                                      \
     using State         = Core::State<GT>;                                     \
     using Action        = Core::Action<GT>;                                    \
-    using ActionList    = Core::StaticVec<Core::Action<GT>, Defs::kMaxValidActions>; \
+    using ActionList    = Core::ActionList<GT>;                                \
     using GameResult    = Core::GameResult<Defs::kNumPlayers>;                 \
     template<typename T>                                                       \
     using Vec           = Core::AlignedVec<T>;                                 \
@@ -6,10 +6,12 @@
 #include <iostream>
 #include <stdexcept>
 #include <cstring>
+#include <algorithm>
 #include <cuda_runtime_api.h>
 #include <NvInfer.h>
 
 #include "../bootstrap/GameConfig.hpp"
+#include "../interfaces/IInferenceBackend.hpp"
 #include "../util/AlignedVec.hpp"
 
 namespace Core
@@ -35,23 +37,6 @@ namespace Core
     };
     inline static TRTLogger g_logger;
 
-    // ========================================================================
-    // MODEL RESULTS 
-    // 
-    // Values: Stores exactly 3 probabilities (Win, Draw, Loss) per player.
-    // Maps identically to the GameResult::wdl schema.
-    // ========================================================================
-    template<ValidGameTraits GT>
-    struct ModelResultsT
-    {
-        USING_GAME_TYPES(GT);
-
-        std::array<float, Defs::kNumPlayers * 3> values{};  // WDL per player
-        std::array<float, Defs::kActionSpace>    policy{};  // Post-softmax probabilities
-
-        ModelResultsT() noexcept = default;
-    };
-
     // ========================================================================
     // TENSORRT WRAPPER 
     // High-throughput, asynchronous GPU inference engine.
@@ -59,31 +44,49 @@ namespace Core
     // Design Intent:
     // Leverages CUDA Streams and Pinned Memory (cudaMallocHost) to execute 
     // Direct Memory Access (DMA) transfers without blocking the CPU thread.
+    //
+    // Every batch slot owns a stream, an execution context, its own pinned and
+    // device buffers and a completion event, so the H2D copy of batch N+1 can
+    // overlap the compute of batch N. Events use blocking sync: a thread
+    // waiting in collect() sleeps instead of spinning on the driver.
     // ========================================================================
     template<ValidGameTraits GT>
-    class NeuralNet
+    class NeuralNet final : public IInferenceBackend<GT>
     {
     private:
         USING_GAME_TYPES(GT);
         using ModelResults = ModelResultsT<GT>;
+        using typename IInferenceBackend<GT>::ResultBatch;
 
         static constexpr uint32_t kValueOutSize = Defs::kNumPlayers * 3;
 
-        int      m_deviceId;
-        uint32_t m_inferenceBatchSize;
+        struct Slot
+        {
+            cudaStream_t                 stream = nullptr;
+            cudaEvent_t                  done = nullptr;
+            nvinfer1::IExecutionContext* context = nullptr;
+
+            float* d_input = nullptr;  // Device VRAM: NN input
+            float* d_values = nullptr; // Device VRAM: WDL output 
+            float* d_policy = nullptr; // Device VRAM: Policy output
+
+            float* h_input = nullptr;  // Pinned RAM: NN input, encoded in place by the caller
+            float* h_values = nullptr; // Pinned RAM: WDL output
+            float* h_policy = nullptr; // Pinned RAM: Policy output
+
+            ResultBatch* results = nullptr; // Set by submit(), consumed by collect()
+            int32_t      batchSize = 0;
+        };
+
+        int         m_deviceId;
+        uint32_t    m_inferenceBatchSize;
+        InputLayout m_layout;
+        uint32_t    m_rowSize;  // Floats per input row in m_layout
 
-        cudaStream_t                 m_stream = nullptr;
         nvinfer1::IRuntime* m_runtime = nullptr;
         nvinfer1::ICudaEngine* m_engine = nullptr;
-        nvinfer1::IExecutionContext* m_context = nullptr;
-
-        float* d_input = nullptr;  // Device VRAM: NN input
-        float* d_values = nullptr; // Device VRAM: WDL output 
-        float* d_policy = nullptr; // Device VRAM: Policy output
 
-        float* h_input = nullptr;  // Pinned RAM: NN input
-        float* h_values = nullptr; // Pinned RAM: WDL output
-        float* h_policy = nullptr; // Pinned RAM: Policy output
+        AlignedVec<Slot> m_slots;
 
         void loadEngine(const std::string& path)
         {
@@ -107,117 +110,170 @@ namespace Core
             m_engine = m_runtime->deserializeCudaEngine(buf.data(), size);
             if (!m_engine) throw std::runtime_error("NeuralNet: deserializeCudaEngine failed.");
 
-            m_context = m_engine->createExecutionContext();
-            if (!m_context) throw std::runtime_error("NeuralNet: createExecutionContext failed.");
+            // The plan's input width tells which layout it was exported for.
+            const nvinfer1::Dims in = m_engine->getTensorShape("input_state");
+            if (in.nbDims != 2 || in.d[1] != static_cast<int64_t>(m_rowSize))
+                throw std::runtime_error("NeuralNet: engine input width does not match backend.inputLayout ("
+                    + std::to_string(m_rowSize) + " floats per position expected): " + path);
+        }
+
+        // A TensorRT execution context runs one inference at a time, so each
+        // slot gets its own (weights stay shared through the engine).
+        void initSlot(Slot& s)
+        {
+            const uint32_t B = m_inferenceBatchSize;
+
+            CUDA_CHECK(cudaStreamCreateWithFlags(&s.stream, cudaStreamNonBlocking));
+            CUDA_CHECK(cudaEventCreateWithFlags(&s.done, cudaEventDisableTiming | cudaEventBlockingSync));
+
+            s.context = m_engine->createExecutionContext();
+            if (!s.context) throw std::runtime_error("NeuralNet: createExecutionContext failed.");
+
+            // Allocate VRAM
+            CUDA_CHECK(cudaMalloc(&s.d_input, B * m_rowSize * sizeof(float)));
+            CUDA_CHECK(cudaMalloc(&s.d_values, B * kValueOutSize * sizeof(float)));
+            CUDA_CHECK(cudaMalloc(&s.d_policy, B * Defs::kActionSpace * sizeof(float)));
+
+            // Allocate Paged-Locked Host Memory (Prevents OS swapping, allows async DMA)
+            CUDA_CHECK(cudaMallocHost(&s.h_input, B * m_rowSize * sizeof(float)));
+            CUDA_CHECK(cudaMallocHost(&s.h_values, B * kValueOutSize * sizeof(float)));
+            CUDA_CHECK(cudaMallocHost(&s.h_policy, B * Defs::kActionSpace * sizeof(float)));
+
+            // Map I/O tensors (Names MUST match the python ONNX exporter)
+            s.context->setTensorAddress("input_state", s.d_input);
+            s.context->setTensorAddress("value_output", s.d_values);
+            s.context->setTensorAddress("policy_output", s.d_policy);
+        }
+
+        static void releaseSlot(Slot& s)
+        {
+            if (s.stream) cudaStreamSynchronize(s.stream);
+
+            cudaFree(s.d_input);  cudaFree(s.d_values);  cudaFree(s.d_policy);
+            cudaFreeHost(s.h_input); cudaFreeHost(s.h_values); cudaFreeHost(s.h_policy);
+
+            if (s.context) { delete s.context; s.context = nullptr; }
+            if (s.done) cudaEventDestroy(s.done);
+            if (s.stream) cudaStreamDestroy(s.stream);
+            s = Slot{};
+        }
+
+        void releaseAll()
+        {
+            for (Slot& s : m_slots) releaseSlot(s);
+            if (m_engine) { delete m_engine;  m_engine = nullptr; }
+            if (m_runtime) { delete m_runtime; m_runtime = nullptr; }
         }
 
     public:
         NeuralNet(int deviceId, uint32_t inferenceBatchSize,
-            const std::string& enginePath)
+            const std::string& enginePath, uint32_t numSlots = 1, InputLayout layout = InputLayout::Dense)
             : m_deviceId(deviceId)
             , m_inferenceBatchSize(inferenceBatchSize)
+            , m_layout(layout)
+            , m_rowSize(layout == InputLayout::Packed ? Defs::kPackedInputSize : Defs::kNNInputSize)
+            , m_slots(std::max(1u, numSlots))
         {
             CUDA_CHECK(cudaSetDevice(m_deviceId));
-            CUDA_CHECK(cudaStreamCreate(&m_stream));
             try {
                 loadEngine(enginePath);
-
-                const uint32_t B = inferenceBatchSize;
-
-                // Allocate VRAM
-                CUDA_CHECK(cudaMalloc(&d_input, B * Defs::kNNInputSize * sizeof(float)));
-                CUDA_CHECK(cudaMalloc(&d_values, B * kValueOutSize * sizeof(float)));
-                CUDA_CHECK(cudaMalloc(&d_policy, B * Defs::kActionSpace * sizeof(float)));
-
-                // Allocate Paged-Locked Host Memory (Prevents OS swapping, allows async DMA)
-                CUDA_CHECK(cudaMallocHost(&h_input, B * Defs::kNNInputSize * sizeof(float)));
-                CUDA_CHECK(cudaMallocHost(&h_values, B * kValueOutSize * sizeof(float)));
-                CUDA_CHECK(cudaMallocHost(&h_policy, B * Defs::kActionSpace * sizeof(float)));
-
-                // Map I/O tensors (Names MUST match the python ONNX exporter)
-                m_context->setTensorAddress("input_state", d_input);
-                m_context->setTensorAddress("value_output", d_values);
-                m_context->setTensorAddress("policy_output", d_policy);
+                for (Slot& s : m_slots) initSlot(s);
             }
             catch (...) {
-                if (m_stream) cudaStreamDestroy(m_stream);
+                releaseAll();
                 throw;
             }
         }
 
-        ~NeuralNet()
+        ~NeuralNet() override
         {
             CUDA_CHECK(cudaSetDevice(m_deviceId));
-            CUDA_CHECK(cudaStreamSynchronize(m_stream));
-            CUDA_CHECK(cudaStreamDestroy(m_stream));
-
-            cudaFree(d_input);  cudaFree(d_values);  cudaFree(d_policy);
-            cudaFreeHost(h_input); cudaFreeHost(h_values); cudaFreeHost(h_policy);
-
-            if (m_context) { delete m_context; m_context = nullptr; }
-            if (m_engine) { delete m_engine;  m_engine = nullptr; }
-            if (m_runtime) { delete m_runtime; m_runtime = nullptr; }
+            releaseAll();
         }
 
         NeuralNet(const NeuralNet&) = delete;
         NeuralNet& operator=(const NeuralNet&) = delete;
 
+        [[nodiscard]] uint32_t         maxBatch() const noexcept override { return m_inferenceBatchSize; }
+        [[nodiscard]] std::string_view name() const noexcept override { return "tensorrt"; }
+        [[nodiscard]] uint32_t         numSlots() const noexcept override { return static_cast<uint32_t>(m_slots.size()); }
+
+        bool bindThread() override {
+            return cudaSetDevice(m_deviceId) == cudaSuccess;
+        }
+
         // ----------------------------------------------------------------
         // BATCH INFERENCE PIPELINE
         // ----------------------------------------------------------------
-        void forwardBatch(
-            const AlignedVec<const std::array<float, Defs::kNNInputSize>*>& batchPtrs,
-            AlignedVec<ModelResults>& results)
+        [[nodiscard]] float* inputBuffer(uint32_t slot) noexcept override { return m_slots[slot].h_input; }
+        [[nodiscard]] InputLayout inputLayout() const noexcept override { return m_layout; }
+
+        void submit(uint32_t slot, uint32_t count, ResultBatch& results) override
         {
-            const int32_t batchSize = static_cast<int32_t>(batchPtrs.size());
+            Slot& s = m_slots[slot];
+            const int32_t batchSize = static_cast<int32_t>(count);
+            s.results = &results;
+            s.batchSize = batchSize;
             if (batchSize == 0) return;
 
+            if (static_cast<uint32_t>(batchSize) > m_inferenceBatchSize)
+                throw std::runtime_error("NeuralNet: batch exceeds inferenceBatchSize.");
             if (results.size() < static_cast<size_t>(batchSize))
                 results.resize(static_cast<size_t>(batchSize));
 
-            CUDA_CHECK(cudaSetDevice(m_deviceId));
-
             // Dynamically adjust execution context for the current batch size
-            m_context->setInputShape(
+            s.context->setInputShape(
                 "input_state",
-                nvinfer1::Dims2{ batchSize, static_cast<int32_t>(Defs::kNNInputSize) });
-
-            // OPTIMIZATION: Consolidate sparse MCTS tensors directly into contiguous Pinned Memory.
-            for (int32_t b = 0; b < batchSize; ++b) {
-                std::memcpy(
-                    h_input + b * Defs::kNNInputSize,
-                    batchPtrs[b]->data(),
-                    Defs::kNNInputSize * sizeof(float)
-                );
-            }
+                nvinfer1::Dims2{ batchSize, static_cast<int32_t>(m_rowSize) });
 
-            const size_t inputBytes = static_cast<size_t>(batchSize) * Defs::kNNInputSize * sizeof(float);
+            const size_t inputBytes = static_cast<size_t>(batchSize) * m_rowSize * sizeof(float);
 
-            // Asynchronous Execution: H2D -> Compute -> D2H
-            CUDA_CHECK(cudaMemcpyAsync(d_input, h_input, inputBytes, cudaMemcpyHostToDevice, m_stream));
-            m_context->enqueueV3(m_stream);
+            // Asynchronous Execution: H2D -> Compute -> D2H -> completion event
+            CUDA_CHECK(cudaMemcpyAsync(s.d_input, s.h_input, inputBytes, cudaMemcpyHostToDevice, s.stream));
+            if (!s.context->enqueueV3(s.stream))
+                throw std::runtime_error("NeuralNet: enqueueV3 failed.");
 
             const size_t valueBytes = static_cast<size_t>(batchSize) * kValueOutSize * sizeof(float);
             const size_t policyBytes = static_cast<size_t>(batchSize) * Defs::kActionSpace * sizeof(float);
 
-            CUDA_CHECK(cudaMemcpyAsync(h_values, d_values, valueBytes, cudaMemcpyDeviceToHost, m_stream));
-            CUDA_CHECK(cudaMemcpyAsync(h_policy, d_policy, policyBytes, cudaMemcpyDeviceToHost, m_stream));
+            CUDA_CHECK(cudaMemcpyAsync(s.h_values, s.d_values, valueBytes, cudaMemcpyDeviceToHost, s.stream));
+            CUDA_CHECK(cudaMemcpyAsync(s.h_policy, s.d_policy, policyBytes, cudaMemcpyDeviceToHost, s.stream));
+            CUDA_CHECK(cudaEventRecord(s.done, s.stream));
+        }
+
+        [[nodiscard]] bool ready(uint32_t slot) override
+        {
+            const Slot& s = m_slots[slot];
+            if (s.batchSize == 0) return true;
+
+            const cudaError_t st = cudaEventQuery(s.done);
+            if (st == cudaErrorNotReady) return false;
+            CUDA_CHECK(st);
+            return true;
+        }
+
+        void collect(uint32_t slot) override
+        {
+            Slot& s = m_slots[slot];
+            if (s.batchSize == 0) return;
 
-            // Block CPU thread until the GPU stream fully completes
-            CUDA_CHECK(cudaStreamSynchronize(m_stream));
+            // Sleeps until this slot's D2H copies land; other slots keep running.
+            CUDA_CHECK(cudaEventSynchronize(s.done));
 
             // Unpack flat host buffers back into structured results
-            for (int32_t b = 0; b < batchSize; ++b) {
+            ResultBatch& results = *s.results;
+            for (int32_t b = 0; b < s.batchSize; ++b) {
                 ModelResults& res = results[static_cast<size_t>(b)];
 
                 std::memcpy(res.values.data(),
-                    h_values + static_cast<size_t>(b) * kValueOutSize,
+                    s.h_values + static_cast<size_t>(b) * kValueOutSize,
                     kValueOutSize * sizeof(float));
 
-                std::memcpy(res.policy.data(),
-                    h_policy + static_cast<size_t>(b) * Defs::kActionSpace,
-                    Defs::kActionSpace * sizeof(float));
+                // Logits stay in pinned memory until this slot is reused.
+                res.policy = s.h_policy + static_cast<size_t>(b) * Defs::kActionSpace;
             }
+            s.results = nullptr;
+            s.batchSize = 0;
         }
     };
 }
\ No newline at end of file
@@ -1,9 +1,12 @@
 ﻿#pragma once
 
 #include <array>
+#include <filesystem>
 #include <fstream>
 #include <random>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include <cstring>
 
 #include "../interfaces/IEngine.hpp"
@@ -22,14 +25,72 @@ namespace Core
 
         static constexpr size_t kMaskBytes = (Defs::kActionSpace + 7) / 8;
 
-        std::array<float, Defs::kNNInputSize>    nnInput;
-        std::array<float, Defs::kActionSpace>    policy;
-        std::array<float, Defs::kNumPlayers * 3> wdlTarget;
-        std::array<uint8_t, kMaskBytes>          legalMovesMask;
+        std::array<float, Defs::kPackedInputSize> nnInput;  // StateEncoder::encodePacked
+        std::array<float, Defs::kActionSpace>     policy;
+        std::array<float, Defs::kNumPlayers * 3>  wdlTarget;
+        std::array<uint8_t, kMaskBytes>           legalMovesMask;
     };
 
 #pragma pack(pop)
 
+    // ========================================================================
+    // DATASET LAYOUT SIDECAR
+    // Each iteration_XXXX.bin is paired with iteration_XXXX.bin.meta.json, which
+    // records the sample layout the file was written with. The Python readers
+    // (dataset.py, orchestrator.py) take the stride from it and refuse files
+    // without one, i.e. dense files from builds before packed storage, rather
+    // than reading them with the wrong stride.
+    // ========================================================================
+    template<ValidGameTraits GT>
+    struct DatasetLayout
+    {
+        USING_GAME_TYPES(GT);
+
+        // Bumped whenever TrainingSample changes shape.
+        // 1: dense nnInput (no sidecar). 2: packed nnInput.
+        static constexpr uint32_t kFormatVersion = 2;
+
+        [[nodiscard]] static std::string json()
+        {
+            std::ostringstream oss;
+            oss << "{\n"
+                << "  \"formatVersion\": " << kFormatVersion << ",\n"
+                << "  \"inputLayout\": \"packed\",\n"
+                << "  \"inputSize\": " << Defs::kPackedInputSize << ",\n"
+                << "  \"sizeofTrainingSample\": " << sizeof(TrainingSample<GT>) << "\n"
+                << "}\n";
+            return oss.str();
+        }
+
+        // Call before appending to 'binPath'. Writes the sidecar for a new file;
+        // throws if the file already holds samples of another (or unknown) layout.
+        static void prepare(const std::string& binPath)
+        {
+            const std::string metaPath = binPath + ".meta.json";
+            const std::string expected = json();
+
+            if (std::filesystem::exists(metaPath)) {
+                std::ifstream in(metaPath);
+                std::ostringstream existing;
+                existing << in.rdbuf();
+                if (existing.str() != expected)
+                    throw std::runtime_error("[Dataset] " + binPath + " was written with another sample layout ("
+                        + metaPath + "). Move it out of the data folder before resuming.");
+                return;
+            }
+
+            std::error_code ec;
+            if (std::filesystem::exists(binPath) && std::filesystem::file_size(binPath, ec) > 0)
+                throw std::runtime_error("[Dataset] " + binPath + " has no layout sidecar (written by an older build, "
+                    "dense layout). Move it out of the data folder before resuming.");
+
+            std::ofstream out(metaPath);
+            out << expected;
+            if (!out)
+                throw std::runtime_error("[Dataset] Cannot write " + metaPath);
+        }
+    };
+
     // ========================================================================
     // REPLAY BUFFER
     // Accumulates self-play transitions in memory until a terminal state is reached.
@@ -69,7 +130,7 @@ namespace Core
         [[nodiscard]] size_t size() const noexcept { return m_samples.size(); }
 
         void recordTurn(
-            const std::array<float, Defs::kNNInputSize>& encodedInput,
+            const std::array<float, Defs::kPackedInputSize>& encodedInput,
             const std::array<float, Defs::kActionSpace>& policy,
             const std::array<bool, Defs::kActionSpace>& legalMaskBool,
             uint32_t currentPlayer)
@@ -78,7 +139,7 @@ namespace Core
             m_viewers.push_back(currentPlayer);
             auto& sample = m_samples.back();
 
-            std::memcpy(sample.nnInput.data(), encodedInput.data(), Defs::kNNInputSize * sizeof(float));
+            std::memcpy(sample.nnInput.data(), encodedInput.data(), Defs::kPackedInputSize * sizeof(float));
             std::memcpy(sample.policy.data(), policy.data(), Defs::kActionSpace * sizeof(float));
 
             // Bit-pack the boolean mask to minimize disk footprint.
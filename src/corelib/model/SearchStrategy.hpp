@@ -7,6 +7,8 @@
 #include <random>
 #include <limits>
 
+#include "../util/VecMath.hpp"
+
 namespace Core
 {
     // ============================================================================
@@ -89,6 +91,14 @@ namespace Core
             edge.totalValue.fetch_add(penalty, std::memory_order_relaxed);
         }
 
+        // Counter-based Gumbel stream: one random key per thread, the counter
+        // advances by the number of draws so successive roots never reuse noise.
+        struct GumbelStream
+        {
+            uint64_t key = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+            uint64_t counter = 0;
+        };
+
         // ====================================================================
         // GUMBEL-TOP-K ROOT SAMPLING 
         // Samples initial actions using Gumbel noise to accelerate policy convergence.
@@ -102,19 +112,18 @@ namespace Core
             uint32_t actualK = std::min(k, nChildren);
             if (actualK == 0) actualK = nChildren; // Safely bypass Gumbel if K is 0
 
-            thread_local std::mt19937 rng{ std::random_device{}() };
-            std::uniform_real_distribution<float> udist(1e-8f, 1.0f);
+            thread_local GumbelStream stream;
 
             // Avoids heap allocation using compile-time bounded arrays.
-            std::array<std::pair<float, uint32_t>, Defs::kMaxValidActions> scores;
+            std::array<float, Defs::kMaxValidActions> noise;
+            std::array<float, Defs::kMaxValidActions> logPrior;
+            VecMath::gumbel(stream.key, stream.counter, noise.data(), nChildren);
+            VecMath::logFloor(priors + startIdx, logPrior.data(), nChildren, 1e-9f, -1e9f);
+            stream.counter += nChildren;
 
-            for (uint32_t i = 0; i < nChildren; ++i) {
-                const float u = udist(rng);
-                const float gumbel = -std::log(-std::log(u));
-                const float prior = priors[startIdx + i];
-                const float logPrior = (prior > 1e-9f) ? std::log(prior) : -1e9f;
-                scores[i] = { gumbel + logPrior, i };
-            }
+            std::array<std::pair<float, uint32_t>, Defs::kMaxValidActions> scores;
+            for (uint32_t i = 0; i < nChildren; ++i)
+                scores[i] = { noise[i] + logPrior[i], i };
 
             // In-place sort to locate the Top-K indices.
             std::partial_sort(scores.begin(), scores.begin() + actualK, scores.begin() + nChildren,
@@ -173,39 +182,20 @@ namespace Core
             const float sigma = (cVisit + maxN) / safeScale;
 
             std::array<float, Defs::kMaxValidActions> logits;
-            float maxLogit = -std::numeric_limits<float>::max();
+            VecMath::logFloor(priors + startIdx, logits.data(), nChildren, 1e-9f, -1e9f);
 
             for (uint32_t i = 0; i < nChildren; ++i) {
-                const float prior = priors[startIdx + i];
-                const float logP = (prior > 1e-9f) ? std::log(prior) : -1e9f;
                 const float n = getPolicyMetric(edges[startIdx + i]);
                 const float qComp = (n >= 1.0f) ? getQ(edges[startIdx + i]) : fallbackQ;
-
-                logits[i] = logP + sigma * qComp;
-                if (logits[i] > maxLogit) maxLogit = logits[i];
+                logits[i] += sigma * qComp;
             }
 
-            // Softmax transformation
-            float expSum = 0.0f;
-            for (uint32_t i = 0; i < nChildren; ++i) {
-                logits[i] = std::exp(logits[i] - maxLogit);
-                expSum += logits[i];
-            }
+            // Softmax transformation (uniform fallback if numeric instability occurs)
+            VecMath::softmax(logits.data(), nChildren);
 
-            if (expSum > 1e-9f) {
-                const float invSum = 1.0f / expSum;
-                for (uint32_t i = 0; i < nChildren; ++i) {
-                    const uint32_t aId = getActionId(i);
-                    if (aId < actionSpace) outPolicy[aId] += logits[i] * invSum;
-                }
-            }
-            else {
-                // Fallback to a uniform distribution if numeric instability occurs
-                const float uni = 1.0f / static_cast<float>(nChildren);
-                for (uint32_t i = 0; i < nChildren; ++i) {
-                    const uint32_t aId = getActionId(i);
-                    if (aId < actionSpace) outPolicy[aId] += uni;
-                }
+            for (uint32_t i = 0; i < nChildren; ++i) {
+                const uint32_t aId = getActionId(i);
+                if (aId < actionSpace) outPolicy[aId] += logits[i];
             }
         }
     };
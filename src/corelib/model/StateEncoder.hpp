@@ -3,7 +3,9 @@
 #include <span>
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <cmath>
+#include <bit>
 
 #include "../interfaces/IEngine.hpp"
 
@@ -24,6 +26,24 @@ namespace Core
     {
         USING_GAME_TYPES(GT);
 
+        // [Type, FactID, OwnerID, SymLog(Value)]: the head shared by every token.
+        template<typename T>
+        static inline void encodeScalars(const T& x, float* outToken) noexcept
+        {
+            outToken[0] = static_cast<float>(x.type());
+            outToken[1] = static_cast<float>(x.factId());
+            outToken[2] = static_cast<float>(x.ownerId());
+
+            // Symmetric Logarithmic Compression: sign(x) * ln(|x| + 1)
+            // Neutralizes extreme value spikes while maintaining directionality.
+            // 0 and +-1 (absent / presence flags) dominate and skip the libm call.
+            static const float kLog1p1 = std::log1p(1.0f);
+            float val = static_cast<float>(x.value());
+            const float mag = std::abs(val);
+            outToken[3] = (mag == 0.0f) ? val
+                : std::copysign(mag == 1.0f ? kLog1p1 : std::log1p(mag), val);
+        }
+
         // ------------------------------------------------------------------------
         // ENCODE FACT 
         // Maps an entity (piece, resource, rule) into a multi-hot spatial token.
@@ -35,21 +55,23 @@ namespace Core
         // ------------------------------------------------------------------------
         static inline void encodeFact(const Fact& fact, float* outToken) noexcept
         {
-            // Identity Base
-            outToken[0] = static_cast<float>(fact.type());
-            outToken[1] = static_cast<float>(fact.factId());
-            outToken[2] = static_cast<float>(fact.ownerId());
-
-            // Symmetric Logarithmic Compression: sign(x) * ln(|x| + 1)
-            // Neutralizes extreme value spikes while maintaining directionality.
-            float val = static_cast<float>(fact.value());
-            outToken[3] = std::copysign(std::log1p(std::abs(val)), val);
+            encodeScalars(fact, outToken);
 
             // Spatial Multi-Hot Mask. Supports imperfect information where an 
             // entity might simultaneously exist across multiple possible tiles.
-            for (uint32_t i = 0; i < Defs::kNumPos; ++i) {
-                outToken[4 + i] = fact.isPossiblePos(i) ? 1.0f : 0.0f;
-            }
+            float* posMask = outToken + 4;
+            std::fill(posMask, posMask + Defs::kNumPos, 0.0f);
+            if (fact.exists())
+                fact.rawLocation().forEachSet([posMask](size_t i) { posMask[i] = 1.0f; });
+        }
+
+        // True when both facts encode to bit-identical tokens (checked on the
+        // fields, without encoding). Dead facts may differ in stale locations.
+        [[nodiscard]] static inline bool sameToken(const Fact& a, const Fact& b) noexcept
+        {
+            return (!a.exists() || a.rawLocation() == b.rawLocation())
+                && std::bit_cast<uint32_t>(a.value()) == std::bit_cast<uint32_t>(b.value())
+                && a.factId() == b.factId() && a.ownerId() == b.ownerId() && a.type() == b.type();
         }
 
         // ------------------------------------------------------------------------
@@ -62,12 +84,7 @@ namespace Core
         // ------------------------------------------------------------------------
         static inline void encodeAction(const Action& action, float* outToken) noexcept
         {
-            outToken[0] = static_cast<float>(action.type());
-            outToken[1] = static_cast<float>(action.factId());
-            outToken[2] = static_cast<float>(action.ownerId());
-
-            float val = static_cast<float>(action.value());
-            outToken[3] = std::copysign(std::log1p(std::abs(val)), val);
+            encodeScalars(action, outToken);
 
             for (uint32_t i = 0; i < Defs::kNumPos; ++i) {
                 outToken[4 + i] = 0.0f;
@@ -91,11 +108,11 @@ namespace Core
         // [ 0 ... kMaxElems-1 ]        -> Physical Board Pieces
         // [ kMaxElems ... kMaxFacts-1] -> Metadata (Rules, Turns, Scores)
         // [ kMaxFacts ... end ]        -> Reverse Chronological Action History
+        // Every token is written exactly once (no up-front clear of the buffer).
         // ------------------------------------------------------------------------
         static inline void encode(const State& state, std::span<const Action> history,
-            std::array<float, Defs::kNNInputSize>& out) noexcept
+            std::span<float, Defs::kNNInputSize> out) noexcept
         {
-            out.fill(0.0f);
             float* baseCursor = out.data();
 
             const auto& allFacts = state.all();
@@ -105,8 +122,43 @@ namespace Core
                 encodeFact(allFacts[i], tokenCursor);
             }
 
-            // Anchors the most recent move to a fixed, predictable tensor index.
-            float* historyCursor = baseCursor + (Defs::kMaxFacts * Defs::kTokenDim);
+            encodeHistory(history, out);
+        }
+
+        // ------------------------------------------------------------------------
+        // INCREMENTAL ENCODING
+        // 'out' must already hold the fact tokens of encode(ref). Rewrites it
+        // into encode(state, history): only fact tokens that differ from ref are
+        // re-encoded, and the history window is rewritten as a whole.
+        //
+        // Design Intent:
+        // A search leaf is a few moves away from its root, so against the root's
+        // encoding (same POV) only the facts touched along the path change.
+        // Returns the number of fact tokens rewritten.
+        // ------------------------------------------------------------------------
+        static inline uint32_t encodeDelta(const State& ref, const State& state, std::span<const Action> history,
+            std::span<float, Defs::kNNInputSize> out) noexcept
+        {
+            const auto& refFacts = ref.all();
+            const auto& allFacts = state.all();
+
+            uint32_t rewritten = 0;
+            for (uint32_t i = 0; i < allFacts.size(); ++i)
+            {
+                if (sameToken(refFacts[i], allFacts[i])) continue;
+                encodeFact(allFacts[i], out.data() + (i * Defs::kTokenDim));
+                ++rewritten;
+            }
+
+            encodeHistory(history, out);
+            return rewritten;
+        }
+
+        // Anchors the most recent move to a fixed, predictable tensor index.
+        // Slots older than the available history are zeroed.
+        static inline void encodeHistory(std::span<const Action> history, std::span<float, Defs::kNNInputSize> out) noexcept
+        {
+            float* historyCursor = out.data() + (Defs::kMaxFacts * Defs::kTokenDim);
             uint32_t histCount = std::min<uint32_t>(static_cast<uint32_t>(history.size()), Defs::kMaxHistory);
 
             for (uint32_t i = 0; i < histCount; ++i)
@@ -115,6 +167,93 @@ namespace Core
                 float* tokenCursor = historyCursor + (i * Defs::kTokenDim);
                 encodeAction(action, tokenCursor);
             }
+
+            std::fill(historyCursor + histCount * Defs::kTokenDim,
+                historyCursor + Defs::kMaxHistory * Defs::kTokenDim, 0.0f);
+        }
+
+        // ------------------------------------------------------------------------
+        // PACKED ENCODING
+        // Same sequence and scalars as encode(), with the spatial part of each
+        // token shrunk from kNumPos floats to kPosWords:
+        //   Fact:   [Type, FactID, OwnerID, SymLog(Value), W0 ... Wk]
+        //           Wj = sum of 2^b over the set positions 8j + b (0..255).
+        //   Action: [Type, FactID, OwnerID, SymLog(Value), Src+1, Dst+1, 0 ...]
+        //           0 = no square (the dense -1/+1 dipole).
+        //
+        // Design Intent:
+        // Every word is a small integer, exact in fp16, so the network can rebuild
+        // the dense token on the device with Div/Floor only (see unpack()). For
+        // chess this is 12 floats per token instead of 68: host->device copies
+        // and dataset files shrink accordingly.
+        // ------------------------------------------------------------------------
+        static inline void encodePacked(const State& state, std::span<const Action> history,
+            std::span<float, Defs::kPackedInputSize> out) noexcept
+        {
+            float* baseCursor = out.data();
+
+            const auto& allFacts = state.all();
+            for (uint32_t i = 0; i < allFacts.size(); ++i)
+                packFact(allFacts[i], baseCursor + (i * Defs::kPackedTokenDim));
+
+            float* historyCursor = baseCursor + (Defs::kMaxFacts * Defs::kPackedTokenDim);
+            uint32_t histCount = std::min<uint32_t>(static_cast<uint32_t>(history.size()), Defs::kMaxHistory);
+
+            for (uint32_t i = 0; i < histCount; ++i)
+                packAction(history[history.size() - 1 - i], historyCursor + (i * Defs::kPackedTokenDim));
+
+            std::fill(historyCursor + histCount * Defs::kPackedTokenDim,
+                historyCursor + Defs::kMaxHistory * Defs::kPackedTokenDim, 0.0f);
+        }
+
+        static inline void packFact(const Fact& fact, float* outToken) noexcept
+        {
+            static_assert(Defs::kPosBitsPerWord == 8, "packFact maps one location byte per word");
+            encodeScalars(fact, outToken);
+
+            std::array<uint8_t, Defs::kPosWords> bytes{};
+            if (fact.exists()) {
+                const auto& loc = fact.rawLocation();
+                for (uint32_t w = 0; w < Defs::kPosWords; ++w) bytes[w] = loc.byte(w);
+            }
+            for (uint32_t w = 0; w < Defs::kPosWords; ++w)
+                outToken[4 + w] = static_cast<float>(bytes[w]);
+        }
+
+        static inline void packAction(const Action& action, float* outToken) noexcept
+        {
+            encodeScalars(action, outToken);
+
+            std::fill(outToken + 4, outToken + Defs::kPackedTokenDim, 0.0f);
+            if (action.isValid()) {
+                if (action.source() < Defs::kNumPos) outToken[4] = static_cast<float>(action.source() + 1);
+                if (action.dest() < Defs::kNumPos)   outToken[5] = static_cast<float>(action.dest() + 1);
+            }
+        }
+
+        // Packed -> dense, bit-identical to encode() on the same input.
+        static inline void unpack(std::span<const float, Defs::kPackedInputSize> in,
+            std::span<float, Defs::kNNInputSize> out) noexcept
+        {
+            for (uint32_t t = 0; t < Defs::kNNSequenceLength; ++t)
+            {
+                const float* src = in.data() + t * Defs::kPackedTokenDim;
+                float* dst = out.data() + t * Defs::kTokenDim;
+
+                std::copy(src, src + 4, dst);
+                std::fill(dst + 4, dst + Defs::kTokenDim, 0.0f);
+
+                if (t < Defs::kMaxFacts) {
+                    for (uint32_t i = 0; i < Defs::kNumPos; ++i) {
+                        const uint32_t w = static_cast<uint32_t>(src[4 + i / Defs::kPosBitsPerWord]);
+                        if ((w >> (i % Defs::kPosBitsPerWord)) & 1u) dst[4 + i] = 1.0f;
+                    }
+                }
+                else {
+                    if (src[4] > 0.0f) dst[4 + static_cast<uint32_t>(src[4]) - 1] = -1.0f;
+                    if (src[5] > 0.0f) dst[4 + static_cast<uint32_t>(src[5]) - 1] = 1.0f;
+                }
+            }
         }
     };
 }
\ No newline at end of file
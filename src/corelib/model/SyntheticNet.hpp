@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include "../interfaces/IInferenceBackend.hpp"
+#include "../util/AlignedVec.hpp"
+
+namespace Core
+{
+    // Latency model of the simulated accelerator (see BackendConfig::synthetic*).
+    struct SyntheticLatency
+    {
+        float fixedUs = 0.0f;    // Per-launch overhead (kernel launch, H2D/D2H copies)
+        float perItemUs = 0.0f;  // Marginal cost of one extra position in the batch
+        float jitter = 0.0f;     // Relative uniform noise applied to the total, in [0, 1]
+    };
+
+    // ========================================================================
+    // SYNTHETIC BACKEND
+    // Stand-in accelerator for profiling the gather -> eval -> backprop
+    // pipeline without a GPU or a trained .plan.
+    //
+    // Design Intent:
+    // Outputs are pure functions of the encoded input tensor, so a given
+    // position always receives the same WDL/policy and search results stay
+    // reproducible across runs and batch sizes. Policy logits follow a
+    // Gaussian-like spread (a few dominant moves, long tail) and WDL comes
+    // from a softmax over hashed logits, mirrored between the two sides of a
+    // 2-player game, which keeps tree shapes close to a real network's.
+    //
+    // Latency is modelled as a single device timeline: concurrent callers
+    // queue behind each other like launches on one GPU, and each call
+    // returns at max(now, deviceFreeAt) + fixed + perItem * batch (+/- jitter).
+    // With several batch slots, submit() only books the device and collect()
+    // sleeps until the booked completion time, mimicking stream overlap.
+    // ========================================================================
+    template<ValidGameTraits GT>
+    class SyntheticNet final : public IInferenceBackend<GT>
+    {
+    private:
+        USING_GAME_TYPES(GT);
+        using typename IInferenceBackend<GT>::ResultBatch;
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr float kPolicyScale = 2.0f;  // Logit stddev-ish; larger = sharper priors
+        static constexpr float kValueScale = 1.5f;
+
+        uint32_t         m_maxBatch;
+        SyntheticLatency m_latency;
+
+        std::mutex        m_deviceMutex;
+        Clock::time_point m_deviceFreeAt{};
+        std::mt19937_64   m_jitterRng{ 0x5EEDULL };
+
+        struct Slot
+        {
+            AlignedVec<float> input;
+            AlignedVec<float> policy;
+            Clock::time_point readyAt{};
+        };
+        AlignedVec<Slot> m_slots;
+
+        static constexpr uint64_t mix64(uint64_t x) noexcept
+        {
+            x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ULL;
+            x ^= x >> 27; x *= 0x94D049BB133111EBULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+        // Symmetric value in [-1, 1), cheap Irwin-Hall(2) bell shape.
+        static float bell(uint64_t h) noexcept
+        {
+            constexpr float kInv = 1.0f / 4294967296.0f;
+            const float a = static_cast<float>(h & 0xFFFFFFFFULL) * kInv;
+            const float b = static_cast<float>(h >> 32) * kInv;
+            return a + b - 1.0f;
+        }
+
+        static uint64_t hashInput(const float* input) noexcept
+        {
+            uint64_t h = 0xCBF29CE484222325ULL;
+            for (size_t i = 0; i < Defs::kNNInputSize; ++i) {
+                uint32_t bits;
+                std::memcpy(&bits, &input[i], sizeof(bits));
+                if (bits) h = mix64(h ^ (bits + 0x9E3779B97F4A7C15ULL * (i + 1)));
+            }
+            return h;
+        }
+
+        static void synthesize(uint64_t seed, ModelResultsT<GT>& out, float* policy) noexcept
+        {
+            for (uint32_t a = 0; a < Defs::kActionSpace; ++a)
+                policy[a] = kPolicyScale * bell(mix64(seed + a));
+            out.policy = policy;
+
+            for (uint32_t p = 0; p < Defs::kNumPlayers; ++p) {
+                float* wdl = out.values.data() + p * 3;
+                if (Defs::kNumPlayers == 2 && p == 1) {
+                    // Zero-sum mirror: opponent's win is our loss.
+                    wdl[0] = out.values[2]; wdl[1] = out.values[1]; wdl[2] = out.values[0];
+                    continue;
+                }
+                const uint64_t h = mix64(seed ^ (0xA5A5A5A5ULL + p));
+                float l[3] = { kValueScale * bell(h), kValueScale * bell(mix64(h + 1)) - 0.5f, kValueScale * bell(mix64(h + 2)) };
+                const float m = std::max({ l[0], l[1], l[2] });
+                float sum = 0.0f;
+                for (float& v : l) { v = std::exp(v - m); sum += v; }
+                for (int k = 0; k < 3; ++k) wdl[k] = l[k] / sum;
+            }
+        }
+
+        Clock::time_point reserveDevice(size_t batchSize)
+        {
+            double us = m_latency.fixedUs + m_latency.perItemUs * static_cast<double>(batchSize);
+
+            std::lock_guard lock(m_deviceMutex);
+            if (m_latency.jitter > 0.0f) {
+                std::uniform_real_distribution<double> noise(-m_latency.jitter, m_latency.jitter);
+                us *= 1.0 + noise(m_jitterRng);
+            }
+            const auto start = std::max(Clock::now(), m_deviceFreeAt);
+            m_deviceFreeAt = start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::micro>(std::max(0.0, us)));
+            return m_deviceFreeAt;
+        }
+
+    public:
+        SyntheticNet(uint32_t maxBatch, const SyntheticLatency& latency, uint32_t numSlots = 1)
+            : m_maxBatch(maxBatch), m_latency(latency), m_slots(std::max(1u, numSlots))
+        {
+            for (Slot& s : m_slots) {
+                s.input.resize(static_cast<size_t>(maxBatch) * Defs::kNNInputSize);
+                s.policy.resize(static_cast<size_t>(maxBatch) * Defs::kActionSpace);
+            }
+
+            std::cout << "[SyntheticNet] Latency model: " << latency.fixedUs << " us + "
+                << latency.perItemUs << " us/item (jitter " << latency.jitter * 100.0f << "%)\n";
+        }
+
+        [[nodiscard]] uint32_t         maxBatch() const noexcept override { return m_maxBatch; }
+        [[nodiscard]] std::string_view name() const noexcept override { return "synthetic"; }
+        [[nodiscard]] uint32_t         numSlots() const noexcept override { return static_cast<uint32_t>(m_slots.size()); }
+
+        [[nodiscard]] float* inputBuffer(uint32_t slot) noexcept override { return m_slots[slot].input.data(); }
+
+        void submit(uint32_t slot, uint32_t count, ResultBatch& results) override
+        {
+            Slot& s = m_slots[slot];
+            if (count > m_maxBatch)
+                throw std::runtime_error("SyntheticNet: batch exceeds maxBatch.");
+            if (count == 0) { s.readyAt = Clock::time_point{}; return; }
+            if (results.size() < count) results.resize(count);
+
+            s.readyAt = reserveDevice(count);
+
+            // Output synthesis overlaps the simulated device time.
+            for (size_t i = 0; i < count; ++i)
+                synthesize(hashInput(s.input.data() + i * Defs::kNNInputSize), results[i],
+                    s.policy.data() + i * Defs::kActionSpace);
+        }
+
+        [[nodiscard]] bool ready(uint32_t slot) override { return Clock::now() >= m_slots[slot].readyAt; }
+
+        void collect(uint32_t slot) override { std::this_thread::sleep_until(m_slots[slot].readyAt); }
+    };
+}
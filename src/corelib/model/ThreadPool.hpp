@@ -5,16 +5,68 @@
 #include <atomic>
 #include <memory>
 #include <chrono>
+#include <array>
+#include <cstdio>
 #include <iostream>
-#include <cuda_runtime.h>
+#include <string>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
 
 #include "BlockingQueue.hpp"
+#include "EventCache.hpp"
 #include "TreeSearch.hpp"
-#include "NeuralNet.hpp"
+#include "../interfaces/IInferenceBackend.hpp"
 #include "../util/AlignedVec.hpp"
 
 namespace Core
 {
+    // Cumulative inference counters sampled by adaptive controllers.
+    // Consumers diff two snapshots to obtain windowed rates.
+    struct PipelineStats
+    {
+        uint64_t batches = 0;     // batches evaluated
+        uint64_t items = 0;       // leaves evaluated
+        uint64_t busyNs = 0;      // wall time with at least one batch in flight, summed over workers
+        uint64_t backlogSum = 0;  // eval-queue depth left behind after each batch pop
+    };
+
+    // Stage rebalancing (backend.rebalanceThreads), as of the last monitor window.
+    struct RebalanceStats
+    {
+        uint32_t moves = 0;           // role changes so far
+        float    idleGather = 0.0f;   // idle fraction of the gather workers
+        float    idleBackprop = 0.0f; // idle fraction of the backprop workers
+    };
+
+    // One stage-rebalancing move, with the window averages that triggered it.
+    struct RoleChange
+    {
+        uint32_t seq = 0;               // 1-based, over the pool's lifetime
+        uint32_t worker = 0;
+        bool     toBackprop = false;    // gather -> backprop, else backprop -> gather
+        uint32_t numGather = 0;         // split after the move
+        uint32_t numBackprop = 0;
+        float    avgReadyQueue = 0.0f;
+        float    avgBackpropQueue = 0.0f;
+        float    idleGather = 0.0f;
+        float    idleBackprop = 0.0f;
+
+        [[nodiscard]] std::string str() const
+        {
+            char buf[192];
+            std::snprintf(buf, sizeof(buf),
+                "[ThreadPool] Rebalance #%u: worker %u %s | gather %u backprop %u | "
+                "readyQ %.1f backpropQ %.1f | idle G %.0f%% B %.0f%%",
+                seq, worker, toBackprop ? "gather -> backprop" : "backprop -> gather",
+                numGather, numBackprop, avgReadyQueue, avgBackpropQueue,
+                idleGather * 100.0f, idleBackprop * 100.0f);
+            return buf;
+        }
+    };
+
     // ========================================================================
     // PIPELINE ORCHESTRATOR
     // Thread pool handling asynchronous MCTS traversal, Neural Network inference, 
@@ -22,9 +74,25 @@ namespace Core
     //
     // Architecture:
     // Implements a strict SEDA (Staged Event-Driven Architecture) pattern. 
-    // Tasks flow through 4 blocking queues (Ready -> FreeCtx -> Eval -> Backprop).
+    // Tasks flow through 3 blocking queues (Ready -> Eval -> Backprop).
     // Threads are rigidly specialized (Gather, Inference, Backprop) to maximize 
     // L1/L2 cache coherency and eliminate lock contention.
+    //
+    // Network Cascade (optional):
+    // A second, smaller backend set with its own eval queue and inference
+    // workers. Gather routes deep or rarely-visited leaves to it (see
+    // BackendConfig::cascade*); the root neighbourhood keeps the full network.
+    //
+    // Context Recycling:
+    // Evaluation contexts are not queued. Each worker owns a LocalEventCache and
+    // trades half-full batches with a shared EventReservoir, so the per-simulation
+    // acquire/release never touches shared state. Contexts are first-touched by
+    // the gather workers that fill them, keeping their pages on the local NUMA node.
+    //
+    // Stage Rebalancing (optional):
+    // Gather and Backprop workers share one thread budget. A monitor thread 
+    // samples queue depths and per-role idle time, and migrates one worker per 
+    // interval toward the starved stage. Inference workers stay GPU-bound.
     // ========================================================================
     template<ValidGameTraits GT>
     class ThreadPool
@@ -33,17 +101,58 @@ namespace Core
         USING_GAME_TYPES(GT);
         using Event = NodeEvent<GT>;
         using ModelResults = ModelResultsT<GT>;
+        using EventCacheT = LocalEventCache<Event>;
 
         struct TreeTask { TreeSearch<GT>* tree; uint32_t targetSims; bool isSelfPlay; };
         struct EvalTask { TreeSearch<GT>* tree; Event* ctx; uint32_t targetSims; bool isSelfPlay; };
 
-        std::shared_ptr<IEngine<GT>>               m_engine;
-        AlignedVec<std::unique_ptr<NeuralNet<GT>>> m_neuralNets;
+        // One in-flight batch of an inference worker.
+        struct BatchSlot
+        {
+            AlignedVec<EvalTask> tasks;
+            AlignedVec<ModelResults> outputs;
+            std::chrono::steady_clock::time_point submittedAt;
+        };
+
+        enum StageRole : uint8_t { ROLE_GATHER = 0, ROLE_BACKPROP = 1 };
+
+        // One cache line per worker: the monitor writes roles, workers poll them.
+        struct alignas(64) StageSlot { std::atomic<uint8_t> role{ ROLE_GATHER }; };
+
+        static constexpr auto     kRolePollTimeout = std::chrono::microseconds(1000);
+        static constexpr auto     kQueueSamplePeriod = std::chrono::milliseconds(5);
+        static constexpr double   kIdleHysteresis = 0.15;
+        static constexpr uint32_t kRoleLogSize = 8;
+        static constexpr uint32_t kGatherBatch = 16;    // Max leaves claimed per gather pass
+
+        // Per-worker buffers of a gather pass, reused across passes.
+        struct GatherScratch
+        {
+            AlignedVec<TreeTask>                  tasks;
+            AlignedVec<EvalTask>                  claimed;    // Leaves awaiting the engine calls
+            AlignedVec<const State*>              states;
+            AlignedVec<std::span<const uint64_t>> histories;
+            AlignedVec<std::optional<GameResult>> results;
+            AlignedVec<ActionList>                actions;
+        };
+
+        std::shared_ptr<BoundEngineT<GT>>          m_engine;
+        AlignedVec<std::shared_ptr<IInferenceBackend<GT>>> m_backends;
+        AlignedVec<std::shared_ptr<IInferenceBackend<GT>>> m_fastBackends;  // Cascade tier (may be empty)
+        std::mutex                                 m_backendMutex;
+        std::atomic<uint32_t>                      m_backendGen{ 0 };
         AlignedVec<std::unique_ptr<Event>>         m_eventPool;
+        std::mutex                                 m_eventPoolMutex;
+        EventReservoir<Event>                      m_eventReservoir;
+        uint32_t                                   m_maxDepth;
+        uint32_t                                   m_cascadeDepth;
+        uint32_t                                   m_cascadeVisits;
+        bool                                       m_incrementalEncoding;
+        bool                                       m_verifyEncoder;
 
         BlockingQueue<TreeTask> m_qReadyTrees;
-        BlockingQueue<Event*>   m_qFree;
         BlockingQueue<EvalTask> m_qEval;
+        BlockingQueue<EvalTask> m_qEvalFast;
         BlockingQueue<EvalTask> m_qBackprop;
 
         std::vector<std::thread> m_workers;
@@ -54,48 +163,138 @@ namespace Core
         std::mutex               m_mainMutex;
         std::condition_variable  m_mainCV;
 
+        uint32_t                 m_numInferenceWorkers = 0;
+        std::atomic<uint64_t>    m_statBatches{ 0 };
+        std::atomic<uint64_t>    m_statItems{ 0 };
+        std::atomic<uint64_t>    m_statBusyNs{ 0 };
+        std::atomic<uint64_t>    m_statBacklog{ 0 };
+
+        std::unique_ptr<StageSlot[]>         m_stageSlots;
+        uint32_t                             m_numStageWorkers = 0;
+        std::array<std::atomic<uint32_t>, 2> m_roleCount{};
+        std::array<std::atomic<uint64_t>, 2> m_roleIdleNs{};
+        std::atomic<uint32_t>                m_roleChanges{ 0 };
+        std::array<std::atomic<float>, 2>    m_roleIdleFrac{};
+        std::array<RoleChange, kRoleLogSize> m_roleLog{};      // Ring, slot (seq - 1) % kRoleLogSize
+        mutable std::mutex                   m_roleLogMutex;
+        std::atomic<bool>                    m_echoRoleChanges{ true };
+        std::mutex                           m_monitorMutex;
+        std::condition_variable              m_monitorCV;
+
+        // nNets counts both tiers (the cascade tier has its own eval queue); it
+        // may be 0 when leaves are evaluated inline (heuristic mode).
         static size_t calcPoolSize(const BackendConfig& cfg, size_t nNets) {
-            return static_cast<size_t>(cfg.numParallelGames * nNets * cfg.queueScale * 2) + 256;
+            return static_cast<size_t>(cfg.numParallelGames * std::max<size_t>(nNets, 1) * cfg.queueScale * 2) + 256;
+        }
+
+        // Contexts a tier can hold inside submitted batches (every slot full).
+        static size_t calcInflightEvents(const AlignedVec<std::shared_ptr<IInferenceBackend<GT>>>& tier) {
+            size_t n = 0;
+            for (const auto& b : tier) n += static_cast<size_t>(b->numSlots()) * b->maxBatch();
+            return n;
+        }
+
+        // Headroom for contexts parked in worker caches and in in-flight batches
+        // of either tier, so stranding can never starve the pipeline below its
+        // nominal pool size.
+        static size_t calcEventCount(const BackendConfig& cfg, size_t nNets, size_t nInflight) {
+            return calcPoolSize(cfg, nNets) + nInflight
+                + static_cast<size_t>(cfg.numSearchThreads + cfg.numBackpropThreads) * EventCacheT::kCapacity;
+        }
+
+        static AlignedVec<std::shared_ptr<IInferenceBackend<GT>>> toShared(
+            AlignedVec<std::unique_ptr<IInferenceBackend<GT>>>&& backends)
+        {
+            AlignedVec<std::shared_ptr<IInferenceBackend<GT>>> out(reserve_only, backends.size());
+            for (auto& b : backends) out.push_back(std::move(b));
+            return out;
         }
 
     public:
-        ThreadPool(std::shared_ptr<IEngine<GT>> engine,
-            AlignedVec<std::unique_ptr<NeuralNet<GT>>>&& nets,
+        ThreadPool(std::shared_ptr<BoundEngineT<GT>> engine,
+            AlignedVec<std::unique_ptr<IInferenceBackend<GT>>>&& backends,
             const BackendConfig& backendCfg,
-            const EngineConfig& engineCfg)
+            const EngineConfig& engineCfg,
+            AlignedVec<std::unique_ptr<IInferenceBackend<GT>>>&& fastBackends = {})
             : m_engine(engine)
-            , m_neuralNets(std::move(nets))
+            , m_backends(toShared(std::move(backends)))
+            , m_fastBackends(toShared(std::move(fastBackends)))
+            , m_eventPool(reserve_only, calcEventCount(backendCfg, m_backends.size() + m_fastBackends.size(),
+                calcInflightEvents(m_backends) + calcInflightEvents(m_fastBackends)))
+            , m_eventReservoir(m_eventPool.capacity())
+            , m_maxDepth(engineCfg.maxDepth)
+            , m_cascadeDepth(backendCfg.cascadeDepth)
+            , m_cascadeVisits(backendCfg.cascadeVisits)
+            , m_incrementalEncoding(backendCfg.incrementalEncoding)
+            , m_verifyEncoder(backendCfg.verifyEncoder)
+            , m_qReadyTrees(calcPoolSize(backendCfg, m_backends.size() + m_fastBackends.size()) * 4)
+            , m_qEval(calcPoolSize(backendCfg, m_backends.size() + m_fastBackends.size()))
+            , m_qEvalFast(m_fastBackends.empty() ? 1 : calcPoolSize(backendCfg, m_backends.size() + m_fastBackends.size()))
+            , m_qBackprop(calcPoolSize(backendCfg, m_backends.size() + m_fastBackends.size()))
             , m_fastDrain(backendCfg.fastDrain)
-            , m_qReadyTrees(calcPoolSize(backendCfg, m_neuralNets.size()) * 4)
-            , m_qFree(calcPoolSize(backendCfg, m_neuralNets.size()))
-            , m_qEval(calcPoolSize(backendCfg, m_neuralNets.size()))
-            , m_qBackprop(calcPoolSize(backendCfg, m_neuralNets.size()))
-            , m_eventPool(reserve_only, calcPoolSize(backendCfg, m_neuralNets.size()))
         {
+            // Contexts are allocated lazily by the gather workers themselves (first touch).
             const size_t nCtx = m_eventPool.capacity();
-            for (size_t i = 0; i < nCtx; ++i) {
-                m_eventPool.push_back(std::make_unique<Event>(engineCfg.maxDepth));
-                m_qFree.push(m_eventPool.back().get());
+            const uint32_t nAlloc = backendCfg.numSearchThreads;
+            auto shareOf = [&](uint32_t i) {
+                return nCtx / nAlloc + (i < nCtx % nAlloc ? 1 : 0);
+            };
+
+            m_roleCount[ROLE_GATHER].store(backendCfg.numSearchThreads, std::memory_order_relaxed);
+            m_roleCount[ROLE_BACKPROP].store(backendCfg.numBackpropThreads, std::memory_order_relaxed);
+
+            if (backendCfg.rebalanceThreads) {
+                m_numStageWorkers = backendCfg.numSearchThreads + backendCfg.numBackpropThreads;
+                m_stageSlots = std::make_unique<StageSlot[]>(m_numStageWorkers);
+                for (uint32_t i = backendCfg.numSearchThreads; i < m_numStageWorkers; ++i)
+                    m_stageSlots[i].role.store(ROLE_BACKPROP, std::memory_order_relaxed);
+
+                for (uint32_t i = 0; i < m_numStageWorkers; ++i)
+                    m_workers.emplace_back(&ThreadPool::loopStage, this, i, i < nAlloc ? shareOf(i) : 0);
+                m_workers.emplace_back(&ThreadPool::loopRebalance, this,
+                    std::chrono::milliseconds(backendCfg.rebalanceIntervalMs));
+            }
+            else {
+                for (uint32_t i = 0; i < backendCfg.numSearchThreads; ++i)
+                    m_workers.emplace_back(&ThreadPool::loopGather, this, shareOf(i));
             }
 
-            for (uint32_t i = 0; i < backendCfg.numSearchThreads; ++i)
-                m_workers.emplace_back(&ThreadPool::loopGather, this);
-
-            // Assign dedicated inference threads pinned to specific GPUs
-            for (uint32_t g = 0; g < static_cast<uint32_t>(m_neuralNets.size()); ++g)
-                for (uint32_t k = 0; k < backendCfg.numInferenceThreads; ++k)
-                    m_workers.emplace_back(&ThreadPool::loopInference, this, static_cast<size_t>(g), backendCfg.inferenceBatchSize);
+            // Assign dedicated inference threads to each backend instance (one per GPU for TensorRT).
+            // The backend's batch slots are split evenly between its threads.
+            auto spawnInference = [&](bool fastTier) {
+                const auto& tier = fastTier ? m_fastBackends : m_backends;
+                for (uint32_t g = 0; g < static_cast<uint32_t>(tier.size()); ++g) {
+                    const uint32_t nThreads = backendCfg.numInferenceThreads;
+                    const uint32_t nSlots = tier[g]->numSlots();
+                    const uint32_t depth = std::max(1u, nSlots / nThreads);
+                    const uint32_t batchSize = fastTier ? tier[g]->maxBatch() : backendCfg.inferenceBatchSize;
+                    for (uint32_t k = 0; k < nThreads; ++k) {
+                        const uint32_t firstSlot = (nSlots >= nThreads) ? k * depth : 0;
+                        m_workers.emplace_back(&ThreadPool::loopInference, this, fastTier, static_cast<size_t>(g),
+                            batchSize, firstSlot, depth);
+                        ++m_numInferenceWorkers;
+                    }
+                }
+            };
+            spawnInference(false);
+            spawnInference(true);
 
-            for (uint32_t i = 0; i < backendCfg.numBackpropThreads; ++i)
-                m_workers.emplace_back(&ThreadPool::loopBackprop, this);
+            if (!backendCfg.rebalanceThreads)
+                for (uint32_t i = 0; i < backendCfg.numBackpropThreads; ++i)
+                    m_workers.emplace_back(&ThreadPool::loopBackprop, this);
         }
 
         ~ThreadPool()
         {
-            m_running = false;
+            {
+                std::lock_guard lock(m_monitorMutex);
+                m_running = false;
+            }
+            m_monitorCV.notify_all();
             m_qReadyTrees.close(m_fastDrain);
-            m_qFree.close(m_fastDrain);
+            m_eventReservoir.close();
             m_qEval.close(m_fastDrain);
+            m_qEvalFast.close(m_fastDrain);
             m_qBackprop.close(m_fastDrain);
             for (auto& t : m_workers) if (t.joinable()) t.join();
         }
@@ -136,119 +335,347 @@ namespace Core
             executeMultipleTrees({ tree }, numSims);
         }
 
+        // Model hot-swap: replaces every full-network backend (the cascade tier is
+        // left alone) with a freshly loaded one of the same shape (count and
+        // slots). Returns immediately; each inference worker retires its in-flight
+        // batches on the old backend and moves over before its next submit, and
+        // the old backend dies with its last worker reference. Both models are
+        // resident for that short window.
+        void swapBackends(AlignedVec<std::unique_ptr<IInferenceBackend<GT>>>&& fresh)
+        {
+            if (fresh.size() != m_backends.size())
+                throw std::invalid_argument("[ThreadPool] swapBackends: backend count mismatch.");
+            for (size_t g = 0; g < fresh.size(); ++g)
+                if (!fresh[g] || fresh[g]->numSlots() != m_backends[g]->numSlots())
+                    throw std::invalid_argument("[ThreadPool] swapBackends: backend slot layout mismatch.");
+
+            std::lock_guard lock(m_backendMutex);
+            for (size_t g = 0; g < fresh.size(); ++g) m_backends[g] = std::move(fresh[g]);
+            m_backendGen.fetch_add(1, std::memory_order_release);
+        }
+
         [[nodiscard]] size_t getReadyQueueSize() const noexcept { return m_qReadyTrees.size(); }
-        [[nodiscard]] size_t getEvalQueueSize() const noexcept { return m_qEval.size(); }
+        [[nodiscard]] size_t getEvalQueueSize() const noexcept { return m_qEval.size() + m_qEvalFast.size(); }
         [[nodiscard]] size_t getBackpropQueueSize() const noexcept { return m_qBackprop.size(); }
-        [[nodiscard]] size_t getFreeEventCount() const noexcept { return m_qFree.size(); }
+        [[nodiscard]] size_t getFreeEventCount() const noexcept { return m_eventReservoir.size(); }
+        [[nodiscard]] uint32_t getNumInferenceWorkers() const noexcept { return m_numInferenceWorkers; }
+        [[nodiscard]] uint32_t getNumGatherWorkers() const noexcept { return m_roleCount[ROLE_GATHER].load(std::memory_order_relaxed); }
+        [[nodiscard]] uint32_t getNumBackpropWorkers() const noexcept { return m_roleCount[ROLE_BACKPROP].load(std::memory_order_relaxed); }
+        [[nodiscard]] uint32_t getRoleChangeCount() const noexcept { return m_roleChanges.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] RebalanceStats getRebalanceStats() const noexcept {
+            RebalanceStats s;
+            s.moves = m_roleChanges.load(std::memory_order_relaxed);
+            s.idleGather = m_roleIdleFrac[ROLE_GATHER].load(std::memory_order_relaxed);
+            s.idleBackprop = m_roleIdleFrac[ROLE_BACKPROP].load(std::memory_order_relaxed);
+            return s;
+        }
+
+        // Role changes go to stderr as they happen, unless a live display shows
+        // them instead (the self-play dashboard, whose in-place redraw a log line
+        // would break).
+        void setRoleChangeEcho(bool enabled) noexcept { m_echoRoleChanges.store(enabled, std::memory_order_relaxed); }
+
+        // Up to kRoleLogSize most recent role changes, oldest first.
+        [[nodiscard]] std::vector<RoleChange> getRecentRoleChanges() const {
+            std::lock_guard lock(m_roleLogMutex);
+            const uint32_t total = m_roleChanges.load(std::memory_order_relaxed);
+            const uint32_t count = std::min(total, kRoleLogSize);
+            std::vector<RoleChange> out;
+            out.reserve(count);
+            for (uint32_t seq = total - count + 1; seq <= total; ++seq)
+                out.push_back(m_roleLog[(seq - 1) % kRoleLogSize]);
+            return out;
+        }
+        [[nodiscard]] uint32_t getBackendGeneration() const noexcept { return m_backendGen.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] PipelineStats getPipelineStats() const noexcept {
+            PipelineStats s;
+            s.batches = m_statBatches.load(std::memory_order_relaxed);
+            s.items = m_statItems.load(std::memory_order_relaxed);
+            s.busyNs = m_statBusyNs.load(std::memory_order_relaxed);
+            s.backlogSum = m_statBacklog.load(std::memory_order_relaxed);
+            return s;
+        }
 
     private:
         // Worker Loop 1: GATHER
         // Pulls free contexts, walks the tree to find an unexpanded leaf node, 
-        // encodes the tensor input, and passes it to the Evaluation queue.
-        void loopGather()
+        // records its POV state and history, and passes it to the Evaluation queue.
+        void loopGather(size_t allocShare)
         {
-            TreeTask tTask;
-            Event* ctx = nullptr;
+            EventCacheT cache(m_eventReservoir);
+            allocateEvents(allocShare);
 
+            GatherScratch g;
+            TreeTask tTask;
             while (m_running)
             {
                 if (!m_qReadyTrees.pop(tTask)) break;
+                if (!gatherBatch(tTask, g, cache)) break;
+            }
+        }
+
+        // Allocates this worker's share of contexts from its own thread so the
+        // OS places their pages on the worker's NUMA node (first-touch policy).
+        void allocateEvents(size_t count)
+        {
+            if (count == 0) return;
+            AlignedVec<std::unique_ptr<Event>> local(reserve_only, count);
+            AlignedVec<Event*> ptrs(reserve_only, count);
+            for (size_t i = 0; i < count; ++i) {
+                local.push_back(std::make_unique<Event>(m_maxDepth));
+                ptrs.push_back(local.back().get());
+            }
+            {
+                std::lock_guard lock(m_eventPoolMutex);
+                for (auto& e : local) m_eventPool.push_back(std::move(e));
+            }
+            m_eventReservoir.putBulk(ptrs.data(), ptrs.size());
+        }
 
-                if (tTask.tree->getSimulationCount() >= tTask.targetSims) {
+        // One gather pass: 'first' plus whatever else is already queued (up to
+        // kGatherBatch tasks, no waiting). Each task descends its tree and claims
+        // a leaf; the claimed leaves are then scored and expanded together
+        // through the engine's batch entry points, so move generation runs over
+        // the whole pass in one call (chess groups it by MoveGenerator status).
+        // Returns false once the reservoir is closed (shutdown).
+        bool gatherBatch(const TreeTask& first, GatherScratch& g, EventCacheT& cache)
+        {
+            g.tasks.clear();
+            g.tasks.push_back(first);
+            m_qReadyTrees.pop_batch(g.tasks, kGatherBatch - 1, std::chrono::microseconds::zero());
+
+            g.claimed.clear();
+            bool open = true;
+            for (const TreeTask& tTask : g.tasks) {
+                if (!open || tTask.tree->getSimulationCount() >= tTask.targetSims) {
                     notifyTaskDone();
                     continue;
                 }
 
-                if (!m_qFree.pop(ctx)) {
+                Event* ctx = nullptr;
+                if (!cache.acquire(ctx)) {
                     notifyTaskDone();
-                    break;
+                    open = false;
+                    continue;
                 }
 
                 tTask.tree->incrementLaunched();
                 ctx->isSelfPlay = tTask.isSelfPlay;
 
-                const bool needEval = tTask.tree->gather(*ctx);
                 EvalTask eTask{ tTask.tree, ctx, tTask.targetSims, tTask.isSelfPlay };
-
-                if (needEval) m_qEval.push(eTask);
-                else          m_qBackprop.push(eTask); // Immediate terminal resolution bypasses GPU
+                if (tTask.tree->selectLeaf(*ctx)) g.claimed.push_back(eTask);
+                else m_qBackprop.push(eTask); // Immediate terminal resolution bypasses GPU
             }
+
+            expandClaimed(g);
+            return open;
         }
 
-        // Worker Loop 2: INFERENCE
-        // Collects encoded state tensors from multiple trees into a single contiguous 
-        // batch, dispatches to TensorRT, and parses the WDL/Policy outputs.
-        void loopInference(size_t gpuIdx, uint32_t configBatchSize)
+        void expandClaimed(GatherScratch& g)
         {
-            if (cudaSetDevice(static_cast<int>(gpuIdx)) != cudaSuccess) {
-                std::cerr << "[ThreadPool] Fatal: cannot bind to GPU " << gpuIdx << "\n";
-                return;
+            const size_t n = g.claimed.size();
+            if (n == 0) return;
+
+            g.states.resize(n);
+            g.histories.resize(n);
+            g.results.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                const Event& e = *g.claimed[i].ctx;
+                g.states[i] = &e.leafState;
+                g.histories[i] = e.fullHashBuffer;
+            }
+            m_engine->getGameResultBatch(g.states, g.histories, g.results);
+
+            // Terminal leaves go straight to backprop; the rest are compacted in
+            // place for move generation.
+            size_t live = 0;
+            for (size_t i = 0; i < n; ++i) {
+                const EvalTask& eTask = g.claimed[i];
+                if (g.results[i]) {
+                    eTask.tree->resolveTerminalLeaf(*eTask.ctx, *g.results[i]);
+                    m_qBackprop.push(eTask);
+                    continue;
+                }
+                g.claimed[live] = eTask;
+                g.states[live] = g.states[i];
+                g.histories[live] = g.histories[i];
+                ++live;
             }
+            if (live == 0) return;
 
-            auto& net = m_neuralNets[gpuIdx];
+            if (g.actions.size() < live) g.actions.resize(live);
+            m_engine->getValidActionsBatch(std::span(g.states.data(), live), std::span(g.histories.data(), live),
+                std::span(g.actions.data(), live));
 
-            AlignedVec<EvalTask> batchTasks(reserve_only, configBatchSize);
-            AlignedVec<ModelResults> batchOutputs(reserve_only, configBatchSize);
+            for (size_t i = 0; i < live; ++i) {
+                const EvalTask& eTask = g.claimed[i];
+                Event& ctx = *eTask.ctx;
+                ctx.validActions = g.actions[i];
 
-            AlignedVec<const std::array<float, Defs::kNNInputSize>*> batchPtrs(reserve_only, configBatchSize);
+                if (eTask.tree->expandLeaf(ctx)) (routeToFastTier(ctx) ? m_qEvalFast : m_qEval).push(eTask);
+                else m_qBackprop.push(eTask);
+            }
+        }
 
-            while (m_running)
-            {
-                batchTasks.clear();
-                const size_t count = m_qEval.pop_batch(batchTasks, configBatchSize, std::chrono::microseconds(1000));
-                if (count == 0) continue;
+        // Cascade routing: deep or rarely-visited leaves go to the small network.
+        [[nodiscard]] bool routeToFastTier(const Event& ctx) const noexcept
+        {
+            if (m_fastBackends.empty()) return false;
+            return (m_cascadeDepth > 0 && ctx.leafDepth() >= m_cascadeDepth)
+                || (m_cascadeVisits > 0 && ctx.parentVisits < m_cascadeVisits);
+        }
 
-                batchPtrs.clear();
-                batchOutputs.resize(count);
+        // Worker Loop 2: INFERENCE
+        // Collects pending leaves from multiple trees, encodes them directly into the 
+        // backend's contiguous input buffer, dispatches the batch, and parses the 
+        // WDL/Policy outputs.
+        //
+        // Pipelining: the worker owns 'depth' backend slots used as a ring. Batches
+        // are retired in submission order, as soon as the backend reports them ready;
+        // while one computes, the next is packed and the previous one unpacked.
+        // A second batch is only launched once a full one is queued, so overlap never
+        // comes at the cost of fragmenting batches under light load.
+        //
+        // Hot-swap: the worker holds its own reference to the backend and only
+        // re-reads its tier when the generation moves, with its ring drained.
+        void loopInference(bool fastTier, size_t backendIdx, uint32_t configBatchSize, uint32_t firstSlot, uint32_t depth)
+        {
+            auto& backends = fastTier ? m_fastBackends : m_backends;
+            auto& qEval = fastTier ? m_qEvalFast : m_qEval;
+
+            std::shared_ptr<IInferenceBackend<GT>> net;
+            uint32_t gen = 0;
 
-                for (const auto& task : batchTasks)
-                    batchPtrs.push_back(&task.ctx->nnInput);
+            auto adopt = [&] {
+                {
+                    std::lock_guard lock(m_backendMutex);
+                    gen = m_backendGen.load(std::memory_order_relaxed);
+                    net = backends[backendIdx];
+                }
+                if (net->bindThread()) return true;
+                std::cerr << "[ThreadPool] Fatal: cannot bind to " << net->name() << " backend " << backendIdx << "\n";
+                return false;
+            };
+            if (!adopt()) return;
+
+            AlignedVec<BatchSlot> ring(depth);
+            for (BatchSlot& s : ring) {
+                s.tasks.reserve(configBatchSize);
+                s.outputs.reserve(configBatchSize);
+            }
 
-                net->forwardBatch(batchPtrs, batchOutputs);
+            uint32_t head = 0;      // Next ring index to submit
+            uint32_t inFlight = 0;
+            auto lastRetire = std::chrono::steady_clock::now();
+
+            auto retireOldest = [&] {
+                const uint32_t r = (head + depth - inFlight) % depth;
+                BatchSlot& s = ring[r];
+                net->collect(firstSlot + r);
+                --inFlight;
+
+                // Device time is counted once even when batches overlap.
+                const auto now = std::chrono::steady_clock::now();
+                const auto busy = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    now - std::max(s.submittedAt, lastRetire)).count();
+                lastRetire = now;
+
+                const size_t count = s.tasks.size();
+                m_statBatches.fetch_add(1, std::memory_order_relaxed);
+                m_statItems.fetch_add(count, std::memory_order_relaxed);
+                m_statBusyNs.fetch_add(static_cast<uint64_t>(busy), std::memory_order_relaxed);
 
                 // Unpack Neural Net output back into individual MCTS evaluation contexts
                 for (size_t i = 0; i < count; ++i)
                 {
-                    EvalTask& eTask = batchTasks[i];
+                    EvalTask& eTask = s.tasks[i];
                     Event* e = eTask.ctx;
-                    const ModelResults& res = batchOutputs[i];
+                    const ModelResults& res = s.outputs[i];
 
                     e->nnWDL = res.values;
+                    e->setPriorsFromLogits(res.policy);
 
-                    float maxLogit = -1e9f;
-                    for (const auto& act : e->validActions) {
-                        const uint32_t idx = m_engine->actionToIdx(act);
-                        if (idx < Defs::kActionSpace) maxLogit = std::max(maxLogit, res.policy[idx]);
-                    }
+                    m_qBackprop.push(eTask);
+                }
+            };
 
-                    float sumExp = 0.0f;
+            while (m_running || inFlight > 0)
+            {
+                // Retire whatever already finished, oldest first.
+                while (inFlight > 0 && net->ready(firstSlot + (head + depth - inFlight) % depth))
+                    retireOldest();
 
-                    for (const auto& act : e->validActions) {
-                        const uint32_t idx = m_engine->actionToIdx(act);
-                        if (idx < Defs::kActionSpace) {
-                            e->policy[idx] = std::exp(res.policy[idx] - maxLogit);
-                            sumExp += e->policy[idx];
-                        }
-                    }
+                if (m_backendGen.load(std::memory_order_acquire) != gen) {
+                    while (inFlight > 0) retireOldest();
+                    if (!adopt()) return;
+                }
 
-                    if (sumExp > 1e-9f) {
-                        const float inv = 1.0f / sumExp;
-                        for (const auto& act : e->validActions) {
-                            const uint32_t idx = m_engine->actionToIdx(act);
-                            if (idx < Defs::kActionSpace) e->policy[idx] *= inv;
-                        }
-                    }
-                    else if (!e->validActions.empty()) {
-                        const float uni = 1.0f / static_cast<float>(e->validActions.size());
-                        for (const auto& act : e->validActions) {
-                            const uint32_t idx = m_engine->actionToIdx(act);
-                            if (idx < Defs::kActionSpace) e->policy[idx] = uni;
+                const bool canSubmit = m_running && inFlight < depth
+                    && (inFlight == 0 || qEval.size() >= configBatchSize);
+
+                if (canSubmit)
+                {
+                    BatchSlot& s = ring[head];
+                    s.tasks.clear();
+                    const auto timeout = std::chrono::microseconds(inFlight == 0 ? 1000 : 0);
+                    const size_t count = qEval.pop_batch(s.tasks, configBatchSize, timeout);
+                    if (count > 0)
+                    {
+                        m_statBacklog.fetch_add(qEval.size(), std::memory_order_relaxed);
+
+                        // Leaves are encoded straight into the backend's staging rows.
+                        float* input = net->inputBuffer(firstSlot + head);
+                        const bool packed = net->inputLayout() == InputLayout::Packed;
+                        for (size_t i = 0; i < count; ++i) {
+                            const Event& ctx = *s.tasks[i].ctx;
+                            if (packed) {
+                                float* row = input + i * Defs::kPackedInputSize;
+                                ctx.encodePackedInput(std::span<float, Defs::kPackedInputSize>(row, Defs::kPackedInputSize));
+                                if (m_verifyEncoder) verifyEncoding(ctx, row, true);
+                            }
+                            else {
+                                float* row = input + i * Defs::kNNInputSize;
+                                ctx.encodeInput(std::span<float, Defs::kNNInputSize>(row, Defs::kNNInputSize), m_incrementalEncoding);
+                                if (m_verifyEncoder) verifyEncoding(ctx, row, false);
+                            }
                         }
-                    }
+                        s.outputs.resize(count);
 
-                    m_qBackprop.push(eTask);
+                        s.submittedAt = std::chrono::steady_clock::now();
+                        net->submit(firstSlot + head, static_cast<uint32_t>(count), s.outputs);
+                        head = (head + 1) % depth;
+                        ++inFlight;
+                        continue;
+                    }
                 }
+
+                // Nothing to launch: block on the oldest batch instead of spinning.
+                if (inFlight > 0) retireOldest();
+            }
+        }
+
+        // backend.verifyEncoder: the row (unpacked first if packed) must match a
+        // from-scratch dense encoding bit for bit.
+        static void verifyEncoding(const Event& e, const float* row, bool packed)
+        {
+            thread_local AlignedVec<float> full(Defs::kNNInputSize);
+            thread_local AlignedVec<float> unpacked(Defs::kNNInputSize);
+            e.encodeInput(std::span<float, Defs::kNNInputSize>(full.data(), Defs::kNNInputSize), false);
+            if (packed) {
+                StateEncoder<GT>::unpack(std::span<const float, Defs::kPackedInputSize>(row, Defs::kPackedInputSize),
+                    std::span<float, Defs::kNNInputSize>(unpacked.data(), Defs::kNNInputSize));
+                row = unpacked.data();
             }
+            if (std::memcmp(full.data(), row, Defs::kNNInputSize * sizeof(float)) == 0) return;
+
+            size_t i = 0;
+            while (std::memcmp(&full[i], &row[i], sizeof(float)) == 0) ++i;
+            std::cerr << "[ThreadPool] Encoder mismatch at token " << i / Defs::kTokenDim
+                << ", feature " << i % Defs::kTokenDim << ": " << (packed ? "packed " : "incremental ") << row[i]
+                << " vs full " << full[i] << "\n";
+            std::abort();
         }
 
         // Worker Loop 3: BACKPROPAGATION
@@ -256,20 +683,135 @@ namespace Core
         // up to the root, then recycles the context.
         void loopBackprop()
         {
+            EventCacheT cache(m_eventReservoir);
             EvalTask eTask;
             while (m_running)
             {
                 if (!m_qBackprop.pop(eTask)) break;
+                backpropStep(eTask, cache);
+            }
+        }
 
-                eTask.tree->backprop(*(eTask.ctx));
-                m_qFree.push(eTask.ctx);
+        void backpropStep(const EvalTask& eTask, EventCacheT& cache)
+        {
+            eTask.tree->backprop(*(eTask.ctx));
+            cache.release(eTask.ctx);
 
-                if (eTask.tree->getSimulationCount() < eTask.targetSims) {
-                    m_qReadyTrees.push({ eTask.tree, eTask.targetSims, eTask.isSelfPlay });
-                }
-                else {
-                    notifyTaskDone();
+            if (eTask.tree->getSimulationCount() < eTask.targetSims) {
+                m_qReadyTrees.push({ eTask.tree, eTask.targetSims, eTask.isSelfPlay });
+            }
+            else {
+                notifyTaskDone();
+            }
+        }
+
+        // Worker Loop 4: FLEXIBLE STAGE (rebalancing enabled)
+        // Serves whichever role the monitor currently assigns. Timed pops bound 
+        // how long a worker can sit on the wrong queue after a role change; the 
+        // waiting time is charged to the role as idle time.
+        void loopStage(uint32_t slot, size_t allocShare)
+        {
+            EventCacheT cache(m_eventReservoir);
+            allocateEvents(allocShare);
+
+            GatherScratch g;
+            TreeTask tTask;
+            EvalTask eTask;
+
+            while (m_running)
+            {
+                const uint8_t role = m_stageSlots[slot].role.load(std::memory_order_acquire);
+                const auto t0 = std::chrono::steady_clock::now();
+
+                const bool got = (role == ROLE_GATHER)
+                    ? m_qReadyTrees.pop_for(tTask, kRolePollTimeout)
+                    : m_qBackprop.pop_for(eTask, kRolePollTimeout);
+
+                const auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - t0).count();
+                m_roleIdleNs[role].fetch_add(static_cast<uint64_t>(waited), std::memory_order_relaxed);
+
+                if (!got) continue;
+
+                if (role == ROLE_GATHER) { if (!gatherBatch(tTask, g, cache)) break; }
+                else backpropStep(eTask, cache);
+            }
+        }
+
+        // Monitor: averages queue depths over the interval, compares per-worker 
+        // idle fractions, and moves at most one worker per interval. Each stage 
+        // always keeps at least one worker so the pipeline cannot deadlock.
+        void loopRebalance(std::chrono::milliseconds interval)
+        {
+            auto windowStart = std::chrono::steady_clock::now();
+            uint64_t readySum = 0, backpropSum = 0, samples = 0;
+
+            std::unique_lock lock(m_monitorMutex);
+            while (m_running)
+            {
+                m_monitorCV.wait_for(lock, kQueueSamplePeriod, [this] { return !m_running; });
+                if (!m_running) break;
+
+                readySum += m_qReadyTrees.size();
+                backpropSum += m_qBackprop.size();
+                ++samples;
+
+                const auto now = std::chrono::steady_clock::now();
+                const double window = std::chrono::duration<double>(now - windowStart).count();
+                if (now - windowStart < interval) continue;
+
+                const double avgReady = static_cast<double>(readySum) / static_cast<double>(samples);
+                const double avgBackprop = static_cast<double>(backpropSum) / static_cast<double>(samples);
+                readySum = backpropSum = samples = 0;
+                windowStart = now;
+
+                rebalanceOnce(window, avgReady, avgBackprop);
+            }
+        }
+
+        void rebalanceOnce(double window, double avgReady, double avgBackprop)
+        {
+            const uint32_t nG = m_roleCount[ROLE_GATHER].load(std::memory_order_relaxed);
+            const uint32_t nB = m_roleCount[ROLE_BACKPROP].load(std::memory_order_relaxed);
+            const double idleG = std::min(1.0, m_roleIdleNs[ROLE_GATHER].exchange(0, std::memory_order_relaxed) * 1e-9 / (window * std::max(1u, nG)));
+            const double idleB = std::min(1.0, m_roleIdleNs[ROLE_BACKPROP].exchange(0, std::memory_order_relaxed) * 1e-9 / (window * std::max(1u, nB)));
+            m_roleIdleFrac[ROLE_GATHER].store(static_cast<float>(idleG), std::memory_order_relaxed);
+            m_roleIdleFrac[ROLE_BACKPROP].store(static_cast<float>(idleB), std::memory_order_relaxed);
+
+            uint8_t from, to;
+            if (idleG - idleB > kIdleHysteresis && avgBackprop >= nB && nG > 1) {
+                from = ROLE_GATHER; to = ROLE_BACKPROP;
+            }
+            else if (idleB - idleG > kIdleHysteresis && avgReady >= nG && nB > 1) {
+                from = ROLE_BACKPROP; to = ROLE_GATHER;
+            }
+            else return;
+
+            for (uint32_t i = m_numStageWorkers; i-- > 0;) {
+                if (m_stageSlots[i].role.load(std::memory_order_relaxed) != from) continue;
+
+                m_stageSlots[i].role.store(to, std::memory_order_release);
+                m_roleCount[from].fetch_sub(1, std::memory_order_relaxed);
+                m_roleCount[to].fetch_add(1, std::memory_order_relaxed);
+
+                RoleChange rc;
+                rc.worker = i;
+                rc.toBackprop = (to == ROLE_BACKPROP);
+                rc.numGather = m_roleCount[ROLE_GATHER].load(std::memory_order_relaxed);
+                rc.numBackprop = m_roleCount[ROLE_BACKPROP].load(std::memory_order_relaxed);
+                rc.avgReadyQueue = static_cast<float>(avgReady);
+                rc.avgBackpropQueue = static_cast<float>(avgBackprop);
+                rc.idleGather = static_cast<float>(idleG);
+                rc.idleBackprop = static_cast<float>(idleB);
+                {
+                    std::lock_guard lock(m_roleLogMutex);
+                    rc.seq = m_roleChanges.load(std::memory_order_relaxed) + 1;
+                    m_roleLog[(rc.seq - 1) % kRoleLogSize] = rc;
+                    m_roleChanges.store(rc.seq, std::memory_order_relaxed);
                 }
+                if (m_echoRoleChanges.load(std::memory_order_relaxed))
+                    std::cerr << rc.str() + "\n";
+                return;
             }
         }
 
@@ -8,10 +8,15 @@
 #include <cmath>
 #include <span>
 #include <array>
+#include <memory>
+#include <algorithm>
+#include <bit>
 
 #include "../bootstrap/GameConfig.hpp"
 #include "../interfaces/IEngine.hpp"
+#include "../interfaces/IEvaluator.hpp"
 #include "../util/PovUtils.hpp"
+#include "../util/VecMath.hpp"
 #include "SearchStrategy.hpp"
 #include "StateEncoder.hpp"
 
@@ -43,10 +48,17 @@ namespace Core
         AlignedVec<uint64_t> pathHashes;
         AlignedVec<uint64_t> fullHashBuffer;
 
-        std::array<float, Defs::kNNInputSize>    nnInput{};
+        // Leaf awaiting evaluation, already in the viewer's POV. The inference
+        // worker encodes it straight into the backend's input buffer, as a delta
+        // against the tree root's encoding for the same viewer when available.
+        State                                 leafState;
+        StaticVec<Action, Defs::kMaxHistory>  leafHistory;
+        const State*                          refState = nullptr;
+        const float*                          refInput = nullptr;
+
         std::array<float, Defs::kNumPlayers * 3> nnWDL{};
         std::array<float, Defs::kNumPlayers * 3> trueWDL{};
-        std::array<float, Defs::kActionSpace>    policy{};
+        std::array<float, Defs::kMaxValidActions> priors{};     // One per validActions entry
 
         ActionList validActions;
 
@@ -54,6 +66,8 @@ namespace Core
         bool collision = false;
         bool isSelfPlay = false; // Triggers Sequential Halving if Gumbel is active
 
+        uint32_t parentVisits = UINT32_MAX; // Visits of the leaf's parent (cascade routing); MAX at the root
+
         explicit NodeEvent(uint32_t maxDepth)
             : path(reserve_only, maxDepth + 1)
             , pathActions(reserve_only, maxDepth)
@@ -69,21 +83,57 @@ namespace Core
             pathHashes.clear();
             validActions.clear();
             fullHashBuffer.clear();
+            leafHistory.clear();
+            refState = nullptr;
+            refInput = nullptr;
 
             nnWDL.fill(0.0f);
             trueWDL.fill(0.0f);
-            policy.fill(0.0f);
 
             leafNodeIdx = 0;
+            parentVisits = UINT32_MAX;
             isTerminal = false;
             collision = false;
             isSelfPlay = false;
         }
 
+        // Number of moves from the search root to the leaf.
+        [[nodiscard]] uint32_t leafDepth() const noexcept {
+            return path.empty() ? 0u : static_cast<uint32_t>(path.size() - 1);
+        }
+
+        void encodeInput(std::span<float, Defs::kNNInputSize> out, bool incremental = true) const noexcept {
+            if (incremental && refInput) {
+                // History tokens are rewritten by encodeDelta; only the facts carry over.
+                std::memcpy(out.data(), refInput, Defs::kMaxFacts * Defs::kTokenDim * sizeof(float));
+                StateEncoder<GT>::encodeDelta(*refState, leafState, leafHistory, out);
+            }
+            else {
+                StateEncoder<GT>::encode(leafState, leafHistory, out);
+            }
+        }
+
+        void encodePackedInput(std::span<float, Defs::kPackedInputSize> out) const noexcept {
+            StateEncoder<GT>::encodePacked(leafState, leafHistory, out);
+        }
+
         [[nodiscard]] float scalarValue(size_t p, bool fromNN) const noexcept {
             const auto& wdl = fromNN ? nnWDL : trueWDL;
             return wdl[p * 3 + 0] - wdl[p * 3 + 2];
         }
+
+        // Masked softmax of a dense logits row (kActionSpace wide) over the legal
+        // moves, written into priors in validActions order. The policy indices
+        // come with the moves (ActionList), so the inference side never calls
+        // back into the engine.
+        void setPriorsFromLogits(const float* logits) noexcept {
+            VecMath::gatherSoftmax(logits, validActions.policyIndices(), validActions.size(), Defs::kActionSpace, priors.data());
+        }
+
+        // In-place softmax of legal-move logits already held in priors.
+        void normalizePriors() noexcept {
+            VecMath::softmax(priors.data(), validActions.size());
+        }
     };
 
     // ========================================================================
@@ -98,6 +148,7 @@ namespace Core
     private:
         USING_GAME_TYPES(GT);
         using Event = NodeEvent<GT>;
+        using EngineT = BoundEngineT<GT>;
         using Strategy = StrategyPUCT<GT>;
         using EdgeData = typename Strategy::EdgeData;
 
@@ -109,7 +160,8 @@ namespace Core
         static constexpr uint8_t FLAG_GUMBEL_APPLIED = 0x08;
 
         const EngineConfig           m_config;
-        std::shared_ptr<IEngine<GT>> m_engine;
+        std::shared_ptr<EngineT>     m_engine;   // Concrete engine when the traits name one (no vtable in the hot loop)
+        std::shared_ptr<const IEvaluator<GT>> m_evaluator; // Inline leaf evaluation; replaces the NN when set
 
         // Struct-of-Arrays Storage
         AlignedVec<AtomicVal<uint8_t>>  m_nodeFlags;
@@ -118,13 +170,21 @@ namespace Core
         AlignedVec<EdgeData>            m_nodeEdges;
         AlignedVec<float>               m_nodePrior;
         AlignedVec<Action>              m_nodeAction;
+        AlignedVec<uint16_t>            m_nodePolicyIdx;   // Policy index of m_nodeAction (from the ActionList)
 
         State                    m_rootState;
         uint32_t                 m_rootIdx = UINT32_MAX;
+
         AlignedVec<Action>       m_realHistory;
         std::vector<uint64_t>    m_realHashHistory;
 
-        std::atomic<uint32_t>    m_nodeCount{ 0 };
+        // Root encoded once per viewer POV (no history): the base leaves are
+        // delta-encoded against. Read-only while a search is running. Empty
+        // unless backend.incrementalEncoding is on (setIncrementalEncoding).
+        AlignedVec<State>        m_refPovState;
+        AlignedVec<float>        m_refInputs;
+
+        std::atomic<uint32_t>    m_nodeCount{ 0 }; // Reserved high-water mark (includes open chunks)
         std::atomic<uint32_t>    m_simulationsLaunched{ 0 };
         std::atomic<uint32_t>    m_simulationsFinished{ 0 };
 
@@ -137,22 +197,135 @@ namespace Core
         uint32_t m_halvingPhase = 0;
         uint32_t m_simsPerHalvingPhase = 0;
 
+        // --------------------------------------------------------------------
+        // CHUNKED NODE ALLOCATION
+        // Expansions are served from per-thread chunks reserved in bulk from 
+        // m_nodeCount, so the shared counter is touched once per chunk instead 
+        // of once per expansion. Cursors are owned by a single thread each 
+        // (relaxed atomics only so metrics can read them); threads beyond 
+        // kAllocSlots fall back to direct reservation. A thread leases the lowest
+        // free slot on its first allocation and returns it on exit, so pools
+        // rebuilt across matches and reloads keep reusing the same cursors.
+        // --------------------------------------------------------------------
+        static constexpr uint32_t kAllocSlots = 64;
+        static constexpr uint32_t kMaxChunkNodes = 4096;
+
+        struct alignas(64) ChunkCursor {
+            std::atomic<uint32_t> next{ 0 };
+            std::atomic<uint32_t> end{ 0 };
+        };
+
+        std::unique_ptr<ChunkCursor[]> m_chunks;
+        uint32_t                       m_chunkNodes;
+
+        static_assert(kAllocSlots == 64, "slot leases are tracked in a 64-bit mask");
+
+        static std::atomic<uint64_t>& allocSlotMask() {
+            static std::atomic<uint64_t> s_used{ 0 };
+            return s_used;
+        }
+
+        struct AllocSlotLease {
+            uint32_t slot = kAllocSlots;
+
+            AllocSlotLease() {
+                auto& used = allocSlotMask();
+                uint64_t cur = used.load(std::memory_order_relaxed);
+                while (~cur != 0) {
+                    const uint32_t s = static_cast<uint32_t>(std::countr_zero(~cur));
+                    if (used.compare_exchange_weak(cur, cur | (1ull << s), std::memory_order_acquire)) {
+                        slot = s;
+                        break;
+                    }
+                }
+            }
+
+            // Release pairs with the next lease's acquire: the cursor's last values
+            // are visible to the thread inheriting it.
+            ~AllocSlotLease() {
+                if (slot < kAllocSlots)
+                    allocSlotMask().fetch_and(~(1ull << slot), std::memory_order_release);
+            }
+        };
+
+        static uint32_t threadAllocSlot() {
+            thread_local const AllocSlotLease lease;
+            return lease.slot;
+        }
+
+        // Reserves up to `want` contiguous nodes (at least `need`). Near capacity the
+        // reservation shrinks to what is left, so the last nodes remain usable.
+        uint32_t reserveRange(uint32_t want, uint32_t need, uint32_t& got) {
+            uint32_t cur = m_nodeCount.load(std::memory_order_relaxed);
+            while (true) {
+                if (cur >= m_config.maxNodes || m_config.maxNodes - cur < need) return UINT32_MAX;
+                got = std::min(want, m_config.maxNodes - cur);
+                if (m_nodeCount.compare_exchange_weak(cur, cur + got, std::memory_order_relaxed))
+                    return cur;
+            }
+        }
+
         uint32_t allocNodes(uint32_t count) {
-            uint32_t idx = m_nodeCount.fetch_add(count, std::memory_order_relaxed);
-            return (idx + count > m_config.maxNodes) ? UINT32_MAX : idx;
+            const uint32_t slot = threadAllocSlot();
+            uint32_t got = 0;
+            if (slot >= kAllocSlots) return reserveRange(count, count, got);
+
+            ChunkCursor& c = m_chunks[slot];
+            uint32_t next = c.next.load(std::memory_order_relaxed);
+            const uint32_t end = c.end.load(std::memory_order_relaxed);
+
+            if (end - next < count) {
+                // Remainder of the old chunk is abandoned: too small for this expansion.
+                const uint32_t base = reserveRange(std::max(m_chunkNodes, count), count, got);
+                if (base == UINT32_MAX) {
+                    c.next.store(end, std::memory_order_relaxed);
+                    return UINT32_MAX;
+                }
+                next = base;
+                c.end.store(base + got, std::memory_order_relaxed);
+            }
+
+            c.next.store(next + count, std::memory_order_relaxed);
+            return next;
+        }
+
+        [[nodiscard]] uint32_t usedNodeCount() const {
+            uint64_t unused = 0;
+            for (uint32_t i = 0; i < kAllocSlots; ++i) {
+                const uint32_t n = m_chunks[i].next.load(std::memory_order_relaxed);
+                const uint32_t e = m_chunks[i].end.load(std::memory_order_relaxed);
+                if (e > n) unused += e - n;
+            }
+            const uint32_t reserved = std::min(m_nodeCount.load(std::memory_order_relaxed), m_config.maxNodes);
+            return static_cast<uint32_t>(reserved - std::min<uint64_t>(unused, reserved));
+        }
+
+        void refreshEncodingRefs() {
+            if (m_refInputs.empty()) return;
+            for (uint32_t v = 0; v < Defs::kNumPlayers; ++v) {
+                m_refPovState[v] = m_rootState;
+                m_engine->changeStatePov(v, m_refPovState[v]);
+                StateEncoder<GT>::encode(m_refPovState[v], {},
+                    std::span<float, Defs::kNNInputSize>(m_refInputs.data() + v * Defs::kNNInputSize, Defs::kNNInputSize));
+            }
         }
 
-        void prepareNodeInput(Event& ctx, const State& leafState) {
-            uint32_t viewer = m_engine->getCurrentPlayer(leafState);
+        // Turns the claimed leaf's state (ctx.leafState) to its viewer's POV in place.
+        void prepareNodeInput(Event& ctx) {
+            uint32_t viewer = m_engine->getCurrentPlayer(ctx.leafState);
             ctx.leafViewer = viewer;
-            State povState = leafState;
-            m_engine->changeStatePov(viewer, povState);
+            m_engine->changeStatePov(viewer, ctx.leafState);
+            if (!m_refInputs.empty()) {
+                ctx.refState = &m_refPovState[viewer];
+                ctx.refInput = m_refInputs.data() + viewer * Defs::kNNInputSize;
+            }
 
             const size_t totalNeeded = Defs::kMaxHistory;
             const size_t realCount = m_realHistory.size();
             const size_t pathCount = ctx.pathActions.size();
 
-            StaticVec<Action, Defs::kMaxHistory> povHistory;
+            auto& povHistory = ctx.leafHistory;
+            povHistory.clear();
 
             const size_t pathTake = std::min(pathCount, totalNeeded);
             const size_t realTake = std::min(realCount, totalNeeded - pathTake);
@@ -168,8 +341,6 @@ namespace Core
                 m_engine->changeActionPov(viewer, a);
                 povHistory.push_back(a);
             }
-
-            StateEncoder<GT>::encode(povState, povHistory, ctx.nnInput);
         }
 
         void applyRootExploration(uint32_t nodeIdx) {
@@ -205,24 +376,62 @@ namespace Core
             dst = src.wdl;
         }
 
+        // Node storage is allocated by the first startSearch rather than up front,
+        // and dropped again by releaseStorage(): parked self-play slots hold none.
+        void allocateStorage() {
+            m_nodeFlags.assign(m_config.maxNodes, AtomicVal<uint8_t>(FLAG_NONE));
+            m_nodeNumChildren.assign(m_config.maxNodes, AtomicVal<uint16_t>(0));
+            m_nodeFirstChild.assign(m_config.maxNodes, AtomicVal<uint32_t>(0));
+            m_nodeEdges.assign(m_config.maxNodes, EdgeData{});
+            m_nodePrior.assign(m_config.maxNodes, 0.0f);
+            m_nodeAction.assign(m_config.maxNodes, Action{});
+            m_nodePolicyIdx.assign(m_config.maxNodes, 0);
+        }
+
+        // Swaps with an empty vector: clear() and '= {}' keep the capacity.
+        template<typename Vec>
+        static void freeVec(Vec& v) { Vec{}.swap(v); }
+
     public:
-        TreeSearch(std::shared_ptr<IEngine<GT>> engine, const EngineConfig& cfg)
+        TreeSearch(std::shared_ptr<EngineT> engine, const EngineConfig& cfg)
             : m_config(cfg), m_engine(engine)
-            , m_nodeFlags(reserve_only, cfg.maxNodes)
-            , m_nodeNumChildren(reserve_only, cfg.maxNodes)
-            , m_nodeFirstChild(reserve_only, cfg.maxNodes)
-            , m_nodeEdges(reserve_only, cfg.maxNodes)
-            , m_nodePrior(reserve_only, cfg.maxNodes)
-            , m_nodeAction(reserve_only, cfg.maxNodes)
             , m_realHistory(reserve_only, Defs::kMaxHistory * 2 + 512)
+            , m_chunks(std::make_unique<ChunkCursor[]>(kAllocSlots))
+            , m_chunkNodes(std::min<uint32_t>(kMaxChunkNodes, std::max<uint32_t>(cfg.maxNodes / kAllocSlots, Defs::kMaxValidActions)))
         {
+            static_assert(std::is_base_of_v<IEngine<GT>, EngineT>, "GT::Engine must implement IEngine<GT>");
+            static_assert(Defs::kActionSpace <= UINT16_MAX, "m_nodePolicyIdx stores policy indices as uint16_t");
             m_realHashHistory.reserve(Defs::kMaxHistory * 2 + 512);
-            m_nodeFlags.assign(cfg.maxNodes, AtomicVal<uint8_t>(FLAG_NONE));
-            m_nodeNumChildren.assign(cfg.maxNodes, AtomicVal<uint16_t>(0));
-            m_nodeFirstChild.assign(cfg.maxNodes, AtomicVal<uint32_t>(0));
-            m_nodeEdges.assign(cfg.maxNodes, EdgeData{});
-            m_nodePrior.assign(cfg.maxNodes, 0.0f);
-            m_nodeAction.assign(cfg.maxNodes, Action{});
+        }
+
+        void setEvaluator(std::shared_ptr<const IEvaluator<GT>> evaluator) { m_evaluator = std::move(evaluator); }
+
+        // Allocates the per-POV root encodings only when leaves are delta-encoded;
+        // otherwise leaves carry no reference and are encoded from scratch.
+        // Called before the first search (startSearch fills the encodings).
+        void setIncrementalEncoding(bool enabled) {
+            if (enabled) {
+                m_refPovState.assign(Defs::kNumPlayers, State{});
+                m_refInputs.assign(static_cast<size_t>(Defs::kNumPlayers) * Defs::kNNInputSize, 0.0f);
+            }
+            else {
+                freeVec(m_refPovState);
+                freeVec(m_refInputs);
+            }
+        }
+
+        // Frees the node arrays of an idle tree (a parked self-play slot). The
+        // next startSearch allocates them again.
+        void releaseStorage() {
+            freeVec(m_nodeFlags);
+            freeVec(m_nodeNumChildren);
+            freeVec(m_nodeFirstChild);
+            freeVec(m_nodeEdges);
+            freeVec(m_nodePrior);
+            freeVec(m_nodeAction);
+            freeVec(m_nodePolicyIdx);
+            m_rootIdx = UINT32_MAX;
+            m_nodeCount.store(0, std::memory_order_relaxed);
         }
 
         void resetCounters() {
@@ -235,7 +444,13 @@ namespace Core
         [[nodiscard]] uint32_t getSimulationCount() const { return m_simulationsFinished.load(std::memory_order_relaxed); }
 
         void startSearch(const State& rootState, std::span<const uint64_t> currentHistory) {
+            // Runs between searches, with no worker touching this tree.
+            if (m_nodeFlags.empty()) allocateStorage();
             m_nodeCount.store(0, std::memory_order_relaxed);
+            for (uint32_t i = 0; i < kAllocSlots; ++i) {
+                m_chunks[i].next.store(0, std::memory_order_relaxed);
+                m_chunks[i].end.store(0, std::memory_order_relaxed);
+            }
             resetCounters();
 
             m_halvingPhase = 0;
@@ -245,15 +460,49 @@ namespace Core
             m_realHashHistory.assign(currentHistory.begin(), currentHistory.end());
             m_realHistory.clear();
 
-            m_rootIdx = allocNodes(1);
+            uint32_t got = 0;
+            m_rootIdx = reserveRange(1, 1, got);
             if (m_rootIdx != UINT32_MAX) {
                 m_nodeFlags[m_rootIdx].val.store(FLAG_NONE, std::memory_order_relaxed);
                 m_nodeNumChildren[m_rootIdx].val.store(0, std::memory_order_relaxed);
             }
             m_rootState = rootState;
+            refreshEncodingRefs();
+        }
+
+        // Gather is split at the engine calls so the caller can batch them over
+        // many contexts: selectLeaf() claims a leaf per context, the caller
+        // scores and generates moves for all claims at once (getGameResultBatch,
+        // getValidActionsBatch), then resolveTerminalLeaf() or expandLeaf()
+        // finishes each one.
+
+        // Claimed leaf the engine scored as game over.
+        void resolveTerminalLeaf(Event& ctx, const GameResult& outcome) {
+            ctx.isTerminal = true;
+            copyWDLFromResult(outcome, ctx.trueWDL);
+            m_nodeFlags[ctx.leafNodeIdx].val.store(FLAG_TERMINAL | FLAG_EXPANDED, std::memory_order_release);
+        }
+
+        // Claimed, non-terminal leaf whose ctx.validActions the caller filled.
+        // Returns true when it still needs the network.
+        bool expandLeaf(Event& ctx) {
+            // Heuristic mode: resolve the leaf here and skip the inference stage.
+            if (m_evaluator) {
+                ctx.leafViewer = m_engine->getCurrentPlayer(ctx.leafState);
+                m_evaluator->evaluate(ctx.leafState, ctx.leafViewer, ctx.validActions, ctx.nnWDL,
+                    std::span<float>(ctx.priors.data(), ctx.validActions.size()));
+                ctx.normalizePriors();
+                return false;
+            }
+
+            prepareNodeInput(ctx);
+            return true;
         }
 
-        bool gather(Event& ctx) {
+        // Descends from the root. Returns true when it claimed an unexpanded
+        // leaf (now FLAG_EXPANDING), leaving the leaf's state in ctx.leafState;
+        // otherwise the context is already resolved and goes to backprop.
+        bool selectLeaf(Event& ctx) {
             bool sp = ctx.isSelfPlay;
             ctx.reset();
             ctx.isSelfPlay = sp;
@@ -296,17 +545,8 @@ namespace Core
                     // Atomic Compare-And-Swap. Ensures only one thread generates valid actions.
                     if (m_nodeFlags[currIdx].val.compare_exchange_strong(expected, FLAG_EXPANDING, std::memory_order_acquire)) {
                         ctx.leafNodeIdx = currIdx;
-
-                        if (auto outcome = m_engine->getGameResult(currState, ctx.fullHashBuffer)) {
-                            ctx.isTerminal = true;
-                            copyWDLFromResult(*outcome, ctx.trueWDL);
-                            m_nodeFlags[currIdx].val.store(FLAG_TERMINAL | FLAG_EXPANDED, std::memory_order_release);
-                            return false;
-                        }
-
                         ctx.isTerminal = false;
-                        prepareNodeInput(ctx, currState);
-                        ctx.validActions = m_engine->getValidActions(currState, ctx.fullHashBuffer);
+                        ctx.leafState = currState;
                         return true;
                     }
                     else {
@@ -330,6 +570,7 @@ namespace Core
                 uint32_t firstChild = m_nodeFirstChild[currIdx].val.load(std::memory_order_relaxed);
                 uint32_t bestChild = firstChild;
                 float    bestScore = -std::numeric_limits<float>::max();
+                uint32_t parentVisits;
 
                 // ----------------------------------------------------------------
                 // SEQUENTIAL HALVING 
@@ -361,7 +602,7 @@ namespace Core
                         }
                     }
 
-                    uint32_t parentVisits = std::max(1u, m_simulationsFinished.load(std::memory_order_relaxed) + m_simulationsLaunched.load(std::memory_order_relaxed));
+                    parentVisits = std::max(1u, m_simulationsFinished.load(std::memory_order_relaxed) + m_simulationsLaunched.load(std::memory_order_relaxed));
                     for (uint32_t i = 0; i < activeCount; ++i) {
                         uint32_t cIdx = firstChild + m_rootActiveChildren[i];
                         float score = Strategy::computeScore(m_nodeEdges[cIdx], parentVisits, m_nodePrior[cIdx], m_config.cPUCT, m_config.fpuValue);
@@ -370,7 +611,6 @@ namespace Core
                 }
                 else
                 {
-                    uint32_t parentVisits;
                     if (currIdx == m_rootIdx) {
                         parentVisits = std::max(1u, m_simulationsFinished.load(std::memory_order_relaxed) + m_simulationsLaunched.load(std::memory_order_relaxed));
                     }
@@ -395,6 +635,7 @@ namespace Core
 
                 currIdx = bestChild;
                 ctx.path.push_back(currIdx);
+                ctx.parentVisits = parentVisits;
 
                 if (++depth >= m_config.maxDepth) {
                     ctx.isTerminal = true;
@@ -422,8 +663,8 @@ namespace Core
                         if (startIdx != UINT32_MAX) {
                             for (uint32_t i = 0; i < nChildren; ++i) {
                                 m_nodeAction[startIdx + i] = ctx.validActions[i];
-                                uint32_t aId = m_engine->actionToIdx(ctx.validActions[i]);
-                                m_nodePrior[startIdx + i] = (aId < Defs::kActionSpace) ? ctx.policy[aId] : 0.0f;
+                                m_nodePolicyIdx[startIdx + i] = ctx.validActions.policyIdx(i);
+                                m_nodePrior[startIdx + i] = ctx.priors[i];
                                 m_nodeFlags[startIdx + i].val.store(FLAG_NONE, std::memory_order_relaxed);
                                 m_nodeEdges[startIdx + i].visitCount.store(0, std::memory_order_relaxed);
                                 m_nodeEdges[startIdx + i].totalValue.store(0.0f, std::memory_order_relaxed);
@@ -478,8 +719,10 @@ namespace Core
             bool reused = false;
             // Evaluates if the current tree can be shifted to the new state instead of 
             // wiping all prior computation data, heavily improving inference speeds.
+            // Fill is measured like getMemoryUsage(): free tails of open chunks stay
+            // usable by their threads after the shift, so they do not count.
             if (m_config.reuseTree && m_rootIdx != UINT32_MAX &&
-                m_nodeCount.load(std::memory_order_relaxed) < (m_config.maxNodes * m_config.memoryThreshold))
+                usedNodeCount() < (m_config.maxNodes * m_config.memoryThreshold))
             {
                 uint8_t flags = m_nodeFlags[m_rootIdx].val.load(std::memory_order_acquire);
                 if (flags & FLAG_EXPANDED) {
@@ -489,6 +732,7 @@ namespace Core
                         if (m_nodeAction[start + i] == actionPlayed) {
                             m_rootIdx = start + i;
                             m_rootState = newState;
+                            refreshEncodingRefs();
                             resetCounters();
                             m_halvingPhase = 0;
                             m_simsPerHalvingPhase = 0;
@@ -570,13 +814,13 @@ namespace Core
                 Strategy::computeImprovedPolicy(
                     start, num, m_nodePrior.data(), m_nodeEdges.data(),
                     m_config.gumbelCVisit, m_config.gumbelCScale,
-                    [this, start](uint32_t offset) -> uint32_t { return m_engine->actionToIdx(m_nodeAction[start + offset]); },
+                    [this, start](uint32_t offset) -> uint32_t { return m_nodePolicyIdx[start + offset]; },
                     Defs::kActionSpace, pol.data());
             }
             else {
                 for (uint32_t i = 0; i < num; ++i) {
                     float    v = static_cast<float>(Strategy::getPolicyMetric(m_nodeEdges[start + i]));
-                    uint32_t id = m_engine->actionToIdx(m_nodeAction[start + i]);
+                    uint32_t id = m_nodePolicyIdx[start + i];
                     if (id < Defs::kActionSpace) pol[id] += v;
                 }
             }
@@ -592,14 +836,26 @@ namespace Core
             uint32_t start = m_nodeFirstChild[m_rootIdx].val.load(std::memory_order_relaxed);
 
             for (uint32_t i = 0; i < num; ++i) {
-                uint32_t id = m_engine->actionToIdx(m_nodeAction[start + i]);
+                uint32_t id = m_nodePolicyIdx[start + i];
                 if (id < Defs::kActionSpace) mask[id] = true;
             }
             return mask;
         }
 
+        // Counts nodes handed out to expansions; space still free inside open 
+        // per-thread chunks is excluded.
         [[nodiscard]] float getMemoryUsage() const {
-            return static_cast<float>(m_nodeCount.load(std::memory_order_relaxed)) / static_cast<float>(m_config.maxNodes);
+            return static_cast<float>(usedNodeCount()) / static_cast<float>(m_config.maxNodes);
+        }
+
+        // Bytes of SoA storage allocated for this tree: maxNodes nodes once it has
+        // searched, whatever the tree actually uses, and 0 after releaseStorage.
+        static constexpr size_t kBytesPerNode =
+            sizeof(AtomicVal<uint8_t>) + sizeof(AtomicVal<uint16_t>) + sizeof(AtomicVal<uint32_t>)
+            + sizeof(EdgeData) + sizeof(float) + sizeof(Action) + sizeof(uint16_t);
+
+        [[nodiscard]] size_t getReservedBytes() const {
+            return m_nodeFlags.capacity() * kBytesPerNode;
         }
     };
 }
\ No newline at end of file
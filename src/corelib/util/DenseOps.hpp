@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define OMA_DENSE_AVX2 1
+#endif
+
+#include "CompilerHints.hpp"
+
+namespace Core
+{
+    // ========================================================================
+    // DENSE OPS
+    // Row-major fp32 kernels for the CPU inference backend.
+    //
+    // Design Intent:
+    // Weights keep the PyTorch nn.Linear layout ([out, in], row-major), so
+    // every output element is a contiguous dot product. linearTile() computes
+    // four input rows per weight row to reuse each loaded weight vector 4x.
+    // AVX2/FMA paths are selected at compile time; the scalar fallbacks are
+    // written so the compiler can still auto-vectorize them.
+    // ========================================================================
+    struct DenseOps
+    {
+#ifdef OMA_DENSE_AVX2
+        static ALWAYS_INLINE float hsum(__m256 v)
+        {
+            __m128 lo = _mm256_castps256_ps128(v);
+            __m128 hi = _mm256_extractf128_ps(v, 1);
+            lo = _mm_add_ps(lo, hi);
+            __m128 sh = _mm_movehdup_ps(lo);
+            __m128 sums = _mm_add_ps(lo, sh);
+            sh = _mm_movehl_ps(sh, sums);
+            sums = _mm_add_ss(sums, sh);
+            return _mm_cvtss_f32(sums);
+        }
+#endif
+
+        static ALWAYS_INLINE float dot(const float* a, const float* b, size_t n)
+        {
+            size_t k = 0;
+            float acc = 0.0f;
+#ifdef OMA_DENSE_AVX2
+            __m256 v0 = _mm256_setzero_ps();
+            __m256 v1 = _mm256_setzero_ps();
+            for (; k + 16 <= n; k += 16) {
+                v0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k), v0);
+                v1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + k + 8), _mm256_loadu_ps(b + k + 8), v1);
+            }
+            for (; k + 8 <= n; k += 8)
+                v0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k), v0);
+            acc = hsum(_mm256_add_ps(v0, v1));
+#endif
+            for (; k < n; ++k) acc += a[k] * b[k];
+            return acc;
+        }
+
+        // Four simultaneous dot products against one shared weight row w.
+        static ALWAYS_INLINE void dot4(const float* x0, const float* x1, const float* x2, const float* x3,
+            const float* w, size_t n, float out[4])
+        {
+            size_t k = 0;
+            float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+#ifdef OMA_DENSE_AVX2
+            __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+            __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+            for (; k + 8 <= n; k += 8) {
+                const __m256 wv = _mm256_loadu_ps(w + k);
+                a0 = _mm256_fmadd_ps(_mm256_loadu_ps(x0 + k), wv, a0);
+                a1 = _mm256_fmadd_ps(_mm256_loadu_ps(x1 + k), wv, a1);
+                a2 = _mm256_fmadd_ps(_mm256_loadu_ps(x2 + k), wv, a2);
+                a3 = _mm256_fmadd_ps(_mm256_loadu_ps(x3 + k), wv, a3);
+            }
+            s0 = hsum(a0); s1 = hsum(a1); s2 = hsum(a2); s3 = hsum(a3);
+#endif
+            for (; k < n; ++k) {
+                const float wk = w[k];
+                s0 += x0[k] * wk; s1 += x1[k] * wk; s2 += x2[k] * wk; s3 += x3[k] * wk;
+            }
+            out[0] = s0; out[1] = s1; out[2] = s2; out[3] = s3;
+        }
+
+        // Y[r, c] = X[r, :] . W[c, :] + bias[c]  for r in [r0, r1), c in [c0, c1).
+        // X is [rows, in], W is [out, in], Y is [rows, out] (all row-major).
+        static void linearTile(const float* X, size_t in, const float* W, const float* bias,
+            size_t out, float* Y, size_t r0, size_t r1, size_t c0, size_t c1, bool relu)
+        {
+            size_t r = r0;
+            for (; r + 4 <= r1; r += 4) {
+                const float* x0 = X + r * in;
+                for (size_t c = c0; c < c1; ++c) {
+                    float s[4];
+                    dot4(x0, x0 + in, x0 + 2 * in, x0 + 3 * in, W + c * in, in, s);
+                    const float b = bias ? bias[c] : 0.0f;
+                    for (size_t i = 0; i < 4; ++i) {
+                        const float v = s[i] + b;
+                        Y[(r + i) * out + c] = relu ? std::max(v, 0.0f) : v;
+                    }
+                }
+            }
+            for (; r < r1; ++r) {
+                for (size_t c = c0; c < c1; ++c) {
+                    const float v = dot(X + r * in, W + c * in, in) + (bias ? bias[c] : 0.0f);
+                    Y[r * out + c] = relu ? std::max(v, 0.0f) : v;
+                }
+            }
+        }
+
+        // y += alpha * x
+        static ALWAYS_INLINE void axpy(float* y, const float* x, float alpha, size_t n)
+        {
+            size_t k = 0;
+#ifdef OMA_DENSE_AVX2
+            const __m256 av = _mm256_set1_ps(alpha);
+            for (; k + 8 <= n; k += 8)
+                _mm256_storeu_ps(y + k, _mm256_fmadd_ps(av, _mm256_loadu_ps(x + k), _mm256_loadu_ps(y + k)));
+#endif
+            for (; k < n; ++k) y[k] += alpha * x[k];
+        }
+
+        // x = LayerNorm(x + residual) * gamma + beta   (PyTorch post-norm semantics)
+        static void addLayerNorm(float* x, const float* residual, const float* gamma, const float* beta,
+            size_t n, float eps = 1e-5f)
+        {
+            float mean = 0.0f;
+            for (size_t k = 0; k < n; ++k) { x[k] += residual[k]; mean += x[k]; }
+            mean /= static_cast<float>(n);
+
+            float var = 0.0f;
+            for (size_t k = 0; k < n; ++k) { const float d = x[k] - mean; var += d * d; }
+            const float inv = 1.0f / std::sqrt(var / static_cast<float>(n) + eps);
+
+            for (size_t k = 0; k < n; ++k) x[k] = (x[k] - mean) * inv * gamma[k] + beta[k];
+        }
+
+        // In-place numerically stable softmax.
+        static void softmax(float* x, size_t n)
+        {
+            float m = x[0];
+            for (size_t k = 1; k < n; ++k) m = std::max(m, x[k]);
+            float sum = 0.0f;
+            for (size_t k = 0; k < n; ++k) { x[k] = std::exp(x[k] - m); sum += x[k]; }
+            const float inv = 1.0f / sum;
+            for (size_t k = 0; k < n; ++k) x[k] *= inv;
+        }
+    };
+}
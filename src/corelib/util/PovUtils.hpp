@@ -3,6 +3,7 @@
 #include <type_traits>
 #include <cassert>
 #include <array>
+#include <bit>
 #include "../model/GameTypes.hpp"
 
 namespace Core
@@ -30,8 +31,117 @@ namespace Core
         using State = Core::State<GT>;
         using Fact = Core::Fact<GT>;
         using Action = Core::Action<GT>;
+        using LocType = typename Defs::LocType;
+        using Storage = typename LocType::Storage;
 
-        enum class SpatialOp { None, Mirror1D, Shift1D, CustomPermutation };
+        static constexpr bool     kPrimitive = LocType::Props::IsPrimitive;
+        static constexpr uint32_t kStorageBits = kPrimitive ? static_cast<uint32_t>(sizeof(Storage) * 8) : 0;
+        static constexpr uint32_t kTableBytes = kPrimitive ? static_cast<uint32_t>(sizeof(Storage)) : 0;
+
+    public:
+        using PosLut = std::array<uint32_t, Defs::kNumPos>;
+
+        // ========================================================================
+        // SPATIAL PERMUTATION
+        // A position permutation, plus (when the location mask fits a primitive)
+        // one 256-entry table per byte of the mask, so a whole mask is permuted
+        // with one lookup + OR per byte instead of a test/set per position.
+        // Built at compile time; a game registers its symmetry once:
+        //   static constexpr auto kFlip = PovUtils<GT>::makePermutation([](uint32_t p) { return p ^ 56; });
+        // and passes it to the doRotateOwnerAndPermuteSpace* overloads below.
+        // ========================================================================
+        struct Permutation
+        {
+            PosLut pos{};
+            std::array<std::array<Storage, 256>, kTableBytes> bytes{};
+        };
+
+        template<typename F>
+        static constexpr Permutation makePermutation(F&& f)
+        {
+            Permutation perm{};
+            for (uint32_t i = 0; i < Defs::kNumPos; ++i) perm.pos[i] = f(i);
+
+            if constexpr (kPrimitive) {
+                for (uint32_t b = 0; b < kTableBytes; ++b) {
+                    for (uint32_t v = 0; v < 256; ++v) {
+                        Storage out = 0;
+                        for (uint32_t k = 0; k < 8; ++k) {
+                            const uint32_t i = b * 8 + k;
+                            if (((v >> k) & 1u) && i < Defs::kNumPos)
+                                out |= static_cast<Storage>(Storage(1) << perm.pos[i]);
+                        }
+                        perm.bytes[b][v] = out;
+                    }
+                }
+            }
+            return perm;
+        }
+
+        // Mirror1D as a table, for code that wants the generic path.
+        static constexpr Permutation kMirror = makePermutation([](uint32_t i) { return (Defs::kNumPos - 1) - i; });
+
+        static LocType permute(const LocType& loc, const Permutation& perm) noexcept
+        {
+            LocType out{};
+            if constexpr (kPrimitive) {
+                for (uint32_t b = 0; b < kTableBytes; ++b)
+                    out.bits |= perm.bytes[b][static_cast<uint8_t>(loc.bits >> (8 * b))];
+            }
+            else {
+                loc.forEachSet([&](size_t i) { out.set(perm.pos[i]); });
+            }
+            return out;
+        }
+
+    private:
+        enum class SpatialOp { None, Mirror1D, Shift1D, CustomPermutation, TablePermutation };
+
+        // Full bit reversal by swapping ever larger halves (bits, pairs, nibbles, bytes...).
+        static constexpr Storage reverseBits(Storage x) noexcept
+        {
+            for (uint32_t s = 1; s < kStorageBits; s <<= 1) {
+                const Storage m = static_cast<Storage>(static_cast<Storage>(~Storage(0)) / static_cast<Storage>((Storage(1) << s) + 1));
+                x = static_cast<Storage>(((x >> s) & m) | ((x & m) << s));
+            }
+            return x;
+        }
+
+        // Whole-mask fast paths: i -> (kNumPos - 1) - i is a bit reversal of the
+        // low kNumPos bits, i -> (i + k) % kNumPos a rotation when they fill the word.
+        static LocType mirror(const LocType& loc) noexcept
+        {
+            if constexpr (kPrimitive) {
+                LocType out{};
+                out.bits = static_cast<Storage>(reverseBits(loc.bits) >> (kStorageBits - Defs::kNumPos));
+                return out;
+            }
+            else {
+                LocType out{};
+                loc.forEachSet([&](size_t i) { out.set((Defs::kNumPos - 1) - i); });
+                return out;
+            }
+        }
+
+        static LocType shift(const LocType& loc, uint32_t offset) noexcept
+        {
+            if constexpr (kPrimitive && Defs::kNumPos == kStorageBits) {
+                LocType out{};
+                out.bits = std::rotl(loc.bits, static_cast<int>(offset % Defs::kNumPos));
+                return out;
+            }
+            else {
+                LocType out{};
+                loc.forEachSet([&](size_t i) { out.set((i + offset) % Defs::kNumPos); });
+                return out;
+            }
+        }
+
+        // Cycles ownership so that the 'viewer' always perceives themselves as Player 0.
+        static constexpr uint32_t ownerShift(uint32_t viewer) noexcept
+        {
+            return (Defs::kNumPlayers - (viewer % Defs::kNumPlayers)) % Defs::kNumPlayers;
+        }
 
         template<typename T>
         static void transformEntity(
@@ -39,17 +149,15 @@ namespace Core
             uint32_t viewer,
             SpatialOp op,
             uint32_t shiftOffset = 0,
-            const std::array<uint32_t, Defs::kNumPos>* lut = nullptr) noexcept
+            const PosLut* lut = nullptr,
+            const Permutation* perm = nullptr) noexcept
         {
             if (viewer == 0) return; // Base perspective requires no rotation
 
             // 1. OWNER ROTATION
-            // Cycles the ownership of pieces so that the 'viewer' always perceives 
-            // themselves as Player 0.
             if (entity.ownerId() < Defs::kNumPlayers)
             {
-                uint32_t ownerShift = (Defs::kNumPlayers - (viewer % Defs::kNumPlayers)) % Defs::kNumPlayers;
-                uint32_t newOwner = (entity.ownerId() + ownerShift) % Defs::kNumPlayers;
+                uint32_t newOwner = (entity.ownerId() + ownerShift(viewer)) % Defs::kNumPlayers;
 
                 if constexpr (std::is_same_v<T, Fact>) {
                     entity.setOwner(newOwner);
@@ -60,54 +168,50 @@ namespace Core
                 }
             }
 
+            if (op == SpatialOp::None) return;
+
             // 2. SPATIAL TRANSFORMATION
             // Projects the physical location of the piece across the board geometry.
-            if (op != SpatialOp::None && entity.exists())
+            if constexpr (std::is_same_v<T, Fact>)
             {
-                if constexpr (std::is_same_v<T, Fact>)
-                {
-                    auto oldLoc = entity.rawLocation();
-                    entity.kill(); // Wipe spatial mask
-                    entity.setValue(1.0f); // Re-awaken semantic presence
-
-                    for (uint32_t i = 0; i < Defs::kNumPos; ++i) {
-                        if (oldLoc.test(i)) {
-                            uint32_t newPos = i;
-                            switch (op) {
-                            case SpatialOp::Mirror1D:
-                                newPos = (Defs::kNumPos - 1) - i;
-                                break;
-                            case SpatialOp::Shift1D:
-                                newPos = (i + shiftOffset) % Defs::kNumPos;
-                                break;
-                            case SpatialOp::CustomPermutation:
-                                assert(lut != nullptr);
-                                newPos = (*lut)[i];
-                                break;
-                            default: break;
-                            }
-                            entity.addPossiblePos(newPos);
-                        }
-                    }
+                if (!entity.exists()) return;
+
+                const LocType& oldLoc = entity.rawLocation();
+                switch (op) {
+                case SpatialOp::Mirror1D:         entity.setLocation(mirror(oldLoc)); break;
+                case SpatialOp::Shift1D:          entity.setLocation(shift(oldLoc, shiftOffset)); break;
+                case SpatialOp::TablePermutation: entity.setLocation(permute(oldLoc, *perm)); break;
+                case SpatialOp::CustomPermutation: {
+                    assert(lut != nullptr);
+                    LocType out{};
+                    oldLoc.forEachSet([&](size_t i) { out.set((*lut)[i]); });
+                    entity.setLocation(out);
+                    break;
                 }
-                else if constexpr (std::is_same_v<T, Action>)
-                {
-                    auto applyOp = [&](uint32_t pos) -> uint32_t {
-                        if (pos == Defs::kNoPos) return Defs::kNoPos;
-
-                        switch (op) {
-                        case SpatialOp::Mirror1D: return (Defs::kNumPos - 1) - pos;
-                        case SpatialOp::Shift1D:  return (pos + shiftOffset) % Defs::kNumPos;
-                        case SpatialOp::CustomPermutation: return (*lut)[pos];
-                        default: return pos;
-                        }
-                        };
+                default: break;
+                }
+            }
+            else if constexpr (std::is_same_v<T, Action>)
+            {
+                // Any configured action moves, whatever its value (e.g. promotion = 0).
+                if (!entity.isValid()) return;
 
-                    uint32_t newSrc = applyOp(entity.source());
-                    uint32_t newDst = applyOp(entity.dest());
+                auto applyOp = [&](uint32_t pos) -> uint32_t {
+                    if (pos >= Defs::kNumPos) return pos;
 
-                    entity.setPos(newSrc, newDst, entity.value());
-                }
+                    switch (op) {
+                    case SpatialOp::Mirror1D: return (Defs::kNumPos - 1) - pos;
+                    case SpatialOp::Shift1D:  return (pos + shiftOffset) % Defs::kNumPos;
+                    case SpatialOp::CustomPermutation: return (*lut)[pos];
+                    case SpatialOp::TablePermutation:  return perm->pos[pos];
+                    default: return pos;
+                    }
+                    };
+
+                uint32_t newSrc = applyOp(entity.source());
+                uint32_t newDst = applyOp(entity.dest());
+
+                entity.setPos(newSrc, newDst, entity.value());
             }
         }
 
@@ -132,6 +236,10 @@ namespace Core
             transformEntity(act, viewer, SpatialOp::CustomPermutation, 0, &lut);
         }
 
+        static void doRotateOwnerAndPermuteSpaceAction(Action& act, uint32_t viewer, const Permutation& perm) noexcept {
+            transformEntity(act, viewer, SpatialOp::TablePermutation, 0, nullptr, &perm);
+        }
+
         // ========================================================================
         // ELEMENTS 
         // Handles physical board entities. Bypasses Zobrist hashing.
@@ -161,6 +269,25 @@ namespace Core
             transformEntity(f, viewer, SpatialOp::CustomPermutation, 0, &lut);
         }
 
+        static void doRotateOwnerAndPermuteSpaceElem(State& state, uint32_t elemIdx, uint32_t viewer, const Permutation& perm) noexcept {
+            assert(elemIdx < Defs::kMaxElems);
+            Fact& f = state.modifyFactNoHash(elemIdx);
+            transformEntity(f, viewer, SpatialOp::TablePermutation, 0, nullptr, &perm);
+        }
+
+        // Whole element range at once (the common case for a POV change).
+        static void doRotateOwnerAndMirrorElems(State& state, uint32_t viewer) noexcept {
+            if (viewer == 0) return;
+            for (uint32_t idx = 0; idx < Defs::kMaxElems; ++idx)
+                transformEntity(state.modifyFactNoHash(idx), viewer, SpatialOp::Mirror1D);
+        }
+
+        static void doRotateOwnerAndPermuteSpaceElems(State& state, uint32_t viewer, const Permutation& perm) noexcept {
+            if (viewer == 0) return;
+            for (uint32_t idx = 0; idx < Defs::kMaxElems; ++idx)
+                transformEntity(state.modifyFactNoHash(idx), viewer, SpatialOp::TablePermutation, 0, nullptr, &perm);
+        }
+
         // ========================================================================
         // METADATA
         // Handles abstract game rules or scoring slots. Bypasses Zobrist hashing.
@@ -189,5 +316,11 @@ namespace Core
             Fact& f = state.modifyFactNoHash(Defs::kMaxElems + metaIdx);
             transformEntity(f, viewer, SpatialOp::CustomPermutation, 0, &lut);
         }
+
+        static void doRotateOwnerAndPermuteSpaceMeta(State& state, uint32_t metaIdx, uint32_t viewer, const Permutation& perm) noexcept {
+            assert(metaIdx < Defs::kMaxMetas);
+            Fact& f = state.modifyFactNoHash(Defs::kMaxElems + metaIdx);
+            transformEntity(f, viewer, SpatialOp::TablePermutation, 0, nullptr, &perm);
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define OMA_VECMATH_AVX2 1
+#endif
+
+#include "CompilerHints.hpp"
+
+namespace Core
+{
+    // ========================================================================
+    // VECTOR MATH
+    // Small fp32 kernels for the per-evaluation search math: masked policy
+    // softmax, log-priors, Gumbel noise.
+    //
+    // Design Intent:
+    // exp/log use the Cephes range reduction + minimax polynomials (about
+    // 1 ulp on the ranges that matter here; exp(-inf) = 0). Tails shorter than
+    // one vector are padded through a stack buffer, so every element goes
+    // through the same polynomial and results do not depend on n % 8.
+    // Gumbel noise comes from a counter-based hash (key, counter + i): no
+    // generator state to carry around, and streams never overlap as long as
+    // each caller advances its counter by the number of draws.
+    // Without AVX2/FMA everything falls back to <cmath>.
+    // ========================================================================
+    struct VecMath
+    {
+        static constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+
+#ifdef OMA_VECMATH_AVX2
+        static ALWAYS_INLINE __m256 exp8(__m256 x)
+        {
+            x = _mm256_min_ps(x, _mm256_set1_ps(88.3762626647949f));
+            x = _mm256_max_ps(x, _mm256_set1_ps(-88.3762626647949f));
+
+            __m256 fx = _mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504088896341f), _mm256_set1_ps(0.5f));
+            fx = _mm256_floor_ps(fx);
+            x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+            x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+
+            __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.3981999507e-3f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073e-3f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894e-2f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201e-1f));
+            y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+
+            __m256i e = _mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(127));
+            e = _mm256_slli_epi32(e, 23);
+            return _mm256_mul_ps(y, _mm256_castsi256_ps(e));
+        }
+
+        // Natural log for x > 0 (non-positive inputs are the caller's business).
+        static ALWAYS_INLINE __m256 log8(__m256 x)
+        {
+            x = _mm256_max_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x00800000))); // Flush denormals
+
+            __m256i bits = _mm256_castps_si256(x);
+            __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+            bits = _mm256_and_si256(bits, _mm256_set1_epi32(~0x7F800000));
+            x = _mm256_or_ps(_mm256_castsi256_ps(bits), _mm256_set1_ps(0.5f));
+
+            // Map the mantissa to [sqrt(1/2), sqrt(2)) - 1.
+            const __m256 small = _mm256_cmp_ps(x, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OS);
+            e = _mm256_sub_ps(e, _mm256_and_ps(_mm256_set1_ps(1.0f), small));
+            x = _mm256_add_ps(_mm256_sub_ps(x, _mm256_set1_ps(1.0f)), _mm256_and_ps(x, small));
+
+            const __m256 z = _mm256_mul_ps(x, x);
+            __m256 y = _mm256_set1_ps(7.0376836292e-2f);
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.1514610310e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.1676998740e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.2420140846e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.4249322787e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.6668057665e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(2.0000714765e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-2.4999993993e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(3.3333331174e-1f));
+            y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+
+            y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+            y = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), y);
+            x = _mm256_add_ps(x, y);
+            return _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), x);
+        }
+
+        // lowbias32 (C. Wellons): full-avalanche 32-bit integer hash.
+        static ALWAYS_INLINE __m256i hash8(__m256i x)
+        {
+            x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+            x = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x7FEB352D));
+            x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+            x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(0x846CA68Bu)));
+            return _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+        }
+
+        // Runs f over x[0, n) eight lanes at a time; the tail goes through a padded buffer.
+        template<typename F>
+        static ALWAYS_INLINE void map8(float* x, size_t n, F f)
+        {
+            size_t k = 0;
+            for (; k + 8 <= n; k += 8)
+                _mm256_storeu_ps(x + k, f(_mm256_loadu_ps(x + k)));
+            if (k < n) {
+                alignas(32) float tmp[8] = {};
+                std::memcpy(tmp, x + k, (n - k) * sizeof(float));
+                _mm256_store_ps(tmp, f(_mm256_load_ps(tmp)));
+                std::memcpy(x + k, tmp, (n - k) * sizeof(float));
+            }
+        }
+#endif
+
+        static ALWAYS_INLINE uint32_t hash32(uint32_t x) noexcept
+        {
+            x ^= x >> 16; x *= 0x7FEB352Du;
+            x ^= x >> 15; x *= 0x846CA68Bu;
+            x ^= x >> 16;
+            return x;
+        }
+
+        // out[i] = in[i] > minIn ? log(in[i]) : floorVal
+        static void logFloor(const float* in, float* out, size_t n, float minIn, float floorVal)
+        {
+            if (out != in) std::memcpy(out, in, n * sizeof(float));
+#ifdef OMA_VECMATH_AVX2
+            const __m256 lo = _mm256_set1_ps(minIn);
+            const __m256 fl = _mm256_set1_ps(floorVal);
+            map8(out, n, [&](__m256 v) {
+                const __m256 ok = _mm256_cmp_ps(v, lo, _CMP_GT_OQ);
+                return _mm256_blendv_ps(fl, log8(v), ok);
+                });
+#else
+            for (size_t i = 0; i < n; ++i) out[i] = (out[i] > minIn) ? std::log(out[i]) : floorVal;
+#endif
+        }
+
+        // In-place numerically stable softmax. Entries at -inf get 0; if nothing
+        // survives (all -inf, or the sum underflows) the result is uniform.
+        static void softmax(float* x, size_t n)
+        {
+            if (n == 0) return;
+
+            float m = kNegInf;
+            for (size_t i = 0; i < n; ++i) m = std::max(m, x[i]);
+
+            float sum = 0.0f;
+            if (m > kNegInf) {
+#ifdef OMA_VECMATH_AVX2
+                const __m256 mv = _mm256_set1_ps(m);
+                map8(x, n, [&](__m256 v) { return exp8(_mm256_sub_ps(v, mv)); });
+                for (size_t i = 0; i < n; ++i) sum += x[i];
+#else
+                for (size_t i = 0; i < n; ++i) { x[i] = std::exp(x[i] - m); sum += x[i]; }
+#endif
+            }
+
+            if (sum > 1e-9f) {
+                const float inv = 1.0f / sum;
+                for (size_t i = 0; i < n; ++i) x[i] *= inv;
+            }
+            else {
+                std::fill(x, x + n, 1.0f / static_cast<float>(n));
+            }
+        }
+
+        // out[i] = logits[idx[i]] (or -inf when idx[i] >= limit), then softmax(out).
+        static void gatherSoftmax(const float* logits, const uint16_t* idx, size_t n, uint32_t limit, float* out)
+        {
+            size_t i = 0;
+#ifdef OMA_VECMATH_AVX2
+            const __m256i lim = _mm256_set1_epi32(static_cast<int>(std::min<uint32_t>(limit, 0x10000)));
+            const __m256 ninf = _mm256_set1_ps(kNegInf);
+            for (; i + 8 <= n; i += 8) {
+                // Zero-extended to 32 bits, so the signed compare below is exact.
+                const __m256i vi = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(idx + i)));
+                const __m256i ok = _mm256_cmpgt_epi32(lim, vi);
+                _mm256_storeu_ps(out + i, _mm256_mask_i32gather_ps(ninf, logits, vi, _mm256_castsi256_ps(ok), 4));
+            }
+#endif
+            for (; i < n; ++i) out[i] = (idx[i] < limit) ? logits[idx[i]] : kNegInf;
+            softmax(out, n);
+        }
+
+        // Standard Gumbel(0, 1) samples: out[i] = -log(-log(u_i)), with u_i in
+        // (0, 1) drawn from the 32-bit counter (counter + i) under a 64-bit key.
+        static void gumbel(uint64_t key, uint64_t counter, float* out, size_t n)
+        {
+            const uint32_t k0 = static_cast<uint32_t>(key);
+            const uint32_t k1 = static_cast<uint32_t>(key >> 32);
+            const uint32_t c0 = static_cast<uint32_t>(counter);
+            constexpr float kInv24 = 1.0f / 16777216.0f;
+
+            size_t i = 0;
+#ifdef OMA_VECMATH_AVX2
+            const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            for (; i < n; i += 8) {
+                __m256i c = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(c0 + static_cast<uint32_t>(i))), lane);
+                c = hash8(_mm256_xor_si256(hash8(_mm256_xor_si256(c, _mm256_set1_epi32(static_cast<int>(k0)))),
+                    _mm256_set1_epi32(static_cast<int>(k1))));
+
+                // Top 24 bits + 0.5 keep u strictly inside (0, 1).
+                const __m256 u = _mm256_mul_ps(
+                    _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(c, 8)), _mm256_set1_ps(0.5f)),
+                    _mm256_set1_ps(kInv24));
+                const __m256 nl = _mm256_sub_ps(_mm256_setzero_ps(), log8(u));
+                const __m256 g = _mm256_sub_ps(_mm256_setzero_ps(), log8(nl));
+
+                if (i + 8 <= n) _mm256_storeu_ps(out + i, g);
+                else {
+                    alignas(32) float tmp[8];
+                    _mm256_store_ps(tmp, g);
+                    std::memcpy(out + i, tmp, (n - i) * sizeof(float));
+                }
+            }
+#else
+            for (; i < n; ++i) {
+                const uint32_t h = hash32(hash32((c0 + static_cast<uint32_t>(i)) ^ k0) ^ k1);
+                const float u = (static_cast<float>(h >> 8) + 0.5f) * kInv24;
+                out[i] = -std::log(-std::log(u));
+            }
+#endif
+        }
+    };
+}
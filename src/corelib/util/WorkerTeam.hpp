@@ -0,0 +1,115 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+
+namespace Core
+{
+    // ========================================================================
+    // WORKER TEAM
+    // Persistent fork-join helper for data-parallel kernels (CPU inference).
+    //
+    // Design Intent:
+    // Threads are spawned once and parked on a condition variable between
+    // jobs, so a parallel region costs one wake-up instead of a thread spawn.
+    // Tasks are claimed through a shared atomic counter (dynamic scheduling),
+    // and the calling thread participates, so a team of size 1 runs inline.
+    // Not reentrant: one parallelFor() at a time per team.
+    // ========================================================================
+    class WorkerTeam
+    {
+        std::vector<std::thread> m_threads;
+
+        std::mutex              m_mutex;
+        std::condition_variable m_cvStart;
+        std::condition_variable m_cvDone;
+        uint64_t                m_generation = 0;
+        bool                    m_stop = false;
+
+        const std::function<void(size_t)>* m_job = nullptr;
+        size_t                             m_numTasks = 0;
+        std::atomic<size_t>                m_nextTask{ 0 };
+        uint32_t                           m_activeHelpers = 0;
+
+        void drain()
+        {
+            const auto& job = *m_job;
+            for (size_t t = m_nextTask.fetch_add(1, std::memory_order_relaxed); t < m_numTasks;
+                t = m_nextTask.fetch_add(1, std::memory_order_relaxed))
+                job(t);
+        }
+
+        void helperLoop()
+        {
+            uint64_t seen = 0;
+            std::unique_lock lock(m_mutex);
+            while (true)
+            {
+                m_cvStart.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen = m_generation;
+
+                lock.unlock();
+                drain();
+                lock.lock();
+
+                if (--m_activeHelpers == 0) m_cvDone.notify_one();
+            }
+        }
+
+    public:
+        explicit WorkerTeam(uint32_t numThreads)
+        {
+            const uint32_t helpers = numThreads > 1 ? numThreads - 1 : 0;
+            m_threads.reserve(helpers);
+            for (uint32_t i = 0; i < helpers; ++i)
+                m_threads.emplace_back(&WorkerTeam::helperLoop, this);
+        }
+
+        ~WorkerTeam()
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_stop = true;
+            }
+            m_cvStart.notify_all();
+            for (auto& t : m_threads) if (t.joinable()) t.join();
+        }
+
+        WorkerTeam(const WorkerTeam&) = delete;
+        WorkerTeam& operator=(const WorkerTeam&) = delete;
+
+        [[nodiscard]] uint32_t size() const noexcept { return static_cast<uint32_t>(m_threads.size()) + 1; }
+
+        // Runs job(0..numTasks-1) across the team and returns once all tasks finished.
+        void parallelFor(size_t numTasks, const std::function<void(size_t)>& job)
+        {
+            if (numTasks == 0) return;
+            if (m_threads.empty() || numTasks == 1) {
+                for (size_t t = 0; t < numTasks; ++t) job(t);
+                return;
+            }
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_job = &job;
+                m_numTasks = numTasks;
+                m_nextTask.store(0, std::memory_order_relaxed);
+                m_activeHelpers = static_cast<uint32_t>(m_threads.size());
+                ++m_generation;
+            }
+            m_cvStart.notify_all();
+
+            drain();
+
+            std::unique_lock lock(m_mutex);
+            m_cvDone.wait(lock, [this] { return m_activeHelpers == 0; });
+            m_job = nullptr;
+        }
+    };
+}
@@ -1,96 +1,190 @@
 #pragma once
-#include <random>
-#include <iostream>
+#include <array>
+#include <cstdint>
+#include <cstddef>
 #include <cassert>
 
 namespace Core
 {
+    // ============================================================================
+    // COMPILE-TIME MERSENNE TWISTER (64-bit)
+    // Bit-exact constexpr replica of std::mt19937_64, which cannot run in a
+    // constant expression. Lets the Zobrist keys be baked into the binary while
+    // staying identical to the historical runtime-generated ones.
+    // ============================================================================
+    class ConstexprMt64
+    {
+    private:
+        static constexpr size_t kN = 312;
+        static constexpr size_t kM = 156;
+        static constexpr uint64_t kMatrixA = 0xB5026F5AA96619E9ULL;
+        static constexpr uint64_t kUpperMask = ~0ULL << 31;
+        static constexpr uint64_t kLowerMask = (1ULL << 31) - 1;
+
+        std::array<uint64_t, kN> m_mt{};
+        size_t m_idx = kN;
+
+        constexpr void twist() noexcept
+        {
+            for (size_t i = 0; i < kN; ++i) {
+                const uint64_t y = (m_mt[i] & kUpperMask) | (m_mt[(i + 1) % kN] & kLowerMask);
+                m_mt[i] = m_mt[(i + kM) % kN] ^ (y >> 1) ^ ((y & 1) ? kMatrixA : 0);
+            }
+            m_idx = 0;
+        }
+
+    public:
+        constexpr explicit ConstexprMt64(uint64_t seed) noexcept
+        {
+            m_mt[0] = seed;
+            for (size_t i = 1; i < kN; ++i)
+                m_mt[i] = 6364136223846793005ULL * (m_mt[i - 1] ^ (m_mt[i - 1] >> 62)) + i;
+        }
+
+        constexpr uint64_t operator()() noexcept
+        {
+            if (m_idx >= kN) twist();
+            uint64_t y = m_mt[m_idx++];
+            y ^= (y >> 29) & 0x5555555555555555ULL;
+            y ^= (y << 17) & 0x71D67FFFEDA60000ULL;
+            y ^= (y << 37) & 0xFFF7EEE000000000ULL;
+            y ^= (y >> 43);
+            return y;
+        }
+    };
+
     // ============================================================================
     // UNIVERSAL ZOBRIST HASHING
-    // 
+    //
     // Design Intent:
-    // Automatically generates and manages random 64-bit keys for every possible 
-    // combination of [Owner] x [FactType] x [Position]. This allows the Engine 
-    // to maintain an O(1) state hash representing the board, which is essential 
-    // for cycle detection (e.g., three-fold repetition in Chess) and MCTS tree 
+    // Automatically generates and manages random 64-bit keys for every possible
+    // combination of [Owner] x [FactType] x [Position]. This allows the Engine
+    // to maintain an O(1) state hash representing the board, which is essential
+    // for cycle detection (e.g., three-fold repetition in Chess) and MCTS tree
     // transposition caching.
+    //
+    // Layout:
+    // One flat, cache-line aligned array indexed by (FactId, Owner, Position),
+    // built at compile time (constinit: no lazy initialization, no guard on the
+    // hot path). All positions of one (fact, owner) pair are contiguous, so the
+    // two keys of a move share a row. Ignored fact types have their rows zeroed,
+    // which removes the per-call mask test.
+    //
+    // Wide keys (GameDefs::kWideHash): each entry is a Hash128 whose 'hi' half
+    // comes from a second, independently seeded stream. Both halves sit side by
+    // side, so the extra stream costs one more XOR per update, not another load.
     // ============================================================================
     template<ValidGameTraits GT>
     class GenericZobrist
     {
     private:
         using Defs = Core::GameDefs<GT>;
+        using Key = typename Defs::HashT;
 
-        // Capacities padded by +1 to safely handle sentinel values 
+        // Capacities padded by +1 to safely handle sentinel values
         // (kNoOwner, kPadFact, kNoPos) without triggering out-of-bounds access.
         static constexpr uint32_t kNumOwnersAlloc = Defs::kNumPlayers + 1;
         static constexpr uint32_t kNumFactsAlloc = Defs::kNumFactTypes + 1;
         static constexpr uint32_t kNumPosAlloc = Defs::kNumPos + 1;
+        static constexpr size_t kNumKeys = size_t(kNumFactsAlloc) * kNumOwnersAlloc * kNumPosAlloc;
 
-        struct ZobristTable
+        [[nodiscard]] static constexpr size_t rowOf(uint32_t factId, uint32_t ownerId) noexcept
         {
-            uint64_t keys[kNumOwnersAlloc][kNumFactsAlloc][kNumPosAlloc];
-            BitsetT<kNumFactsAlloc> hashMask;
-
-            ZobristTable()
-            {
-                std::cout << "[Zobrist] Initializing RNG keys for Game..." << std::endl;
+            return (size_t(factId) * kNumOwnersAlloc + ownerId) * kNumPosAlloc;
+        }
 
-                // Fixed seed guarantees identical hashes across distributed cluster nodes.
-                std::mt19937_64 rng(123456789ULL);
+        struct alignas(64) ZobristTable
+        {
+            std::array<Key, kNumKeys> keys{};
+        };
 
-                for (uint32_t o = 0; o < kNumOwnersAlloc; ++o) {
-                    for (uint32_t f = 0; f < kNumFactsAlloc; ++f) {
-                        for (uint32_t p = 0; p < kNumPosAlloc; ++p) {
-                            keys[o][f][p] = rng();
-                        }
+        static constexpr ZobristTable makeTable() noexcept
+        {
+            ZobristTable t{};
+
+            // Fixed seed guarantees identical hashes across distributed cluster nodes.
+            // Keys are drawn in [Owner][Fact][Pos] order, as they always have been.
+            ConstexprMt64 rng(123456789ULL);
+            ConstexprMt64 rngHi(987654321ULL);
+
+            for (uint32_t o = 0; o < kNumOwnersAlloc; ++o) {
+                for (uint32_t f = 0; f < kNumFactsAlloc; ++f) {
+                    for (uint32_t p = 0; p < kNumPosAlloc; ++p) {
+                        if constexpr (Defs::kWideHash) t.keys[rowOf(f, o) + p] = Key{ rng(), rngHi() };
+                        else                           t.keys[rowOf(f, o) + p] = rng();
                     }
                 }
+            }
 
-                hashMask.setRange(0, kNumFactsAlloc - 1);
+            // The padding fact never contributes, whatever its owner or position.
+            for (uint32_t o = 0; o < kNumOwnersAlloc; ++o) {
+                for (uint32_t p = 0; p < kNumPosAlloc; ++p) t.keys[rowOf(Defs::kPadFact, o) + p] = Key{};
             }
-        };
+            return t;
+        }
+
+        static inline constinit ZobristTable s_table = makeTable();
 
-        // Meyers Singleton implementation guarantees thread-safe initialization 
-        // without requiring explicit mutex locking during runtime.
-        static ZobristTable& getTable() noexcept
+        // Zeroes every key of a fact type: it then contributes nothing to any hash.
+        static void ignoreFactType(uint32_t factId) noexcept
         {
-            static ZobristTable instance;
-            return instance;
+            for (uint32_t o = 0; o < kNumOwnersAlloc; ++o) {
+                const size_t row = rowOf(factId, o);
+                for (uint32_t p = 0; p < kNumPosAlloc; ++p) s_table.keys[row + p] = Key{};
+            }
         }
 
     public:
-        // Allows the Engine to selectively ignore certain entities in the hash calculation 
+        // Allows the Engine to selectively ignore certain entities in the hash calculation
         // (e.g., ignoring a turn counter to recognize a repeating physical board layout).
+        // Must be called during setup, before any State is hashed.
         static void ignoreElemType(uint32_t elemId) noexcept
         {
             assert(elemId < Defs::kNumElemTypes);
-            getTable().hashMask.unset(elemId);
+            ignoreFactType(elemId);
         }
 
         static void ignoreMetaType(uint32_t metaId) noexcept
         {
             assert(metaId < Defs::kNumMetaTypes);
-            getTable().hashMask.unset(Defs::kNumElemTypes + metaId);
+            ignoreFactType(Defs::kNumElemTypes + metaId);
         }
 
-        static uint64_t getKey(const Fact<GT>& f) noexcept
+        // Raw table entry. Positions range over [0, kNumPos] (kNoPos included).
+        [[nodiscard]] static Key key(uint32_t factId, uint32_t ownerId, uint32_t pos) noexcept
         {
-            // Dead or padding entities inherently contribute nothing to the state hash.
-            if (!f.exists()) return 0;
-            if (f.factId() == Defs::kPadFact) return 0;
+            assert(factId < kNumFactsAlloc && ownerId < kNumOwnersAlloc && pos < kNumPosAlloc);
+            return s_table.keys[rowOf(factId, ownerId) + pos];
+        }
 
-            auto& table = getTable();
+        // ------------------------------------------------------------------------
+        // MOVE DELTA
+        // Hash change of a live, single-square fact relocating from 'from' to 'to'.
+        // A quiet move is then one XOR on the state hash (see State::moveElem).
+        // Both keys come from the same row, usually the same few cache lines.
+        // ------------------------------------------------------------------------
+        [[nodiscard]] static Key moveKey(uint32_t factId, uint32_t ownerId, uint32_t from, uint32_t to) noexcept
+        {
+            assert(factId < kNumFactsAlloc && ownerId < kNumOwnersAlloc);
+            assert(from < kNumPosAlloc && to < kNumPosAlloc);
+            const Key* row = s_table.keys.data() + rowOf(factId, ownerId);
+            return row[from] ^ row[to];
+        }
 
-            if (!table.hashMask.test(f.factId())) return 0;
+        [[nodiscard]] static Key getKey(const Fact<GT>& f) noexcept
+        {
+            // Dead or padding entities inherently contribute nothing to the state hash.
+            // (Padding and ignored types also hold all-zero rows.)
+            if (!f.exists()) return Key{};
 
+            const Key* row = s_table.keys.data() + rowOf(f.factId(), f.ownerId());
             uint32_t singlePos = f.pos();
 
             // PATH 1: Perfect Information (Entity is collapsed to a single square).
             // Represents 99.9% of calls in deterministic games. Optimized for O(1).
             if (singlePos != Defs::kNoPos)
             {
-                return table.keys[f.ownerId()][f.factId()][singlePos];
+                return row[singlePos];
             }
 
             const auto& loc = f.rawLocation();
@@ -99,18 +193,14 @@ namespace Core
             // The hash incorporates all possible locations via XOR blending.
             if (loc.popcount() > 1)
             {
-                uint64_t h = 0;
-                for (size_t p = 0; p < Defs::kNumPos; ++p) {
-                    if (loc.test(p)) {
-                        h ^= table.keys[f.ownerId()][f.factId()][p];
-                    }
-                }
+                Key h{};
+                loc.forEachSet([&h, row](size_t p) { h ^= row[p]; });
                 return h;
             }
 
             // PATH 3: Metadata or Off-Board Entity.
             // Entity actively influences the state but possesses no spatial footprint.
-            return table.keys[f.ownerId()][f.factId()][Defs::kNoPos];
+            return row[Defs::kNoPos];
         }
     };
-}
\ No newline at end of file
+}
@@ -5,11 +5,80 @@
 #include <cassert>
 #include <cctype>
 #include <bit>
+#include <random>
+#include <utility>
+#include <vector>
 
 namespace Chess
 {
 	USING_GAME_TYPES(ChessTypes);
 
+	namespace
+	{
+		// Batch dispatch: one entry per MoveGenerator<Status> specialization, each
+		// running its generator over a whole status group back to back.
+		using GenerateGroupFn = void(*)(const State* const*, const uint32_t*, size_t, ActionList*);
+		using AnyMoveGroupFn = void(*)(const State* const*, const uint32_t*, size_t, uint8_t*);
+
+		template<uint8_t Status>
+		void generateGroup(const State* const* states, const uint32_t* members, size_t count, ActionList* out)
+		{
+			for (size_t k = 0; k < count; ++k) {
+				const uint32_t i = members[k];
+				out[i].clear();
+				MoveGenerator<Status>::generate(states[i]->ext().bb, out[i]);
+			}
+		}
+
+		template<uint8_t Status>
+		void anyMoveGroup(const State* const* states, const uint32_t* members, size_t count, uint8_t* out)
+		{
+			for (size_t k = 0; k < count; ++k)
+				out[members[k]] = MoveGenerator<Status>::hasAnyLegalMove(states[members[k]]->ext().bb);
+		}
+
+		template<size_t... S>
+		constexpr std::array<GenerateGroupFn, 64> makeGenerateTable(std::index_sequence<S...>) {
+			return { &generateGroup<static_cast<uint8_t>(S)>... };
+		}
+
+		template<size_t... S>
+		constexpr std::array<AnyMoveGroupFn, 64> makeAnyMoveTable(std::index_sequence<S...>) {
+			return { &anyMoveGroup<static_cast<uint8_t>(S)>... };
+		}
+
+		constexpr auto kGenerateGroup = makeGenerateTable(std::make_index_sequence<64>{});
+		constexpr auto kAnyMoveGroup = makeAnyMoveTable(std::make_index_sequence<64>{});
+
+		// Per-thread scratch reused across batches: status, and the batch
+		// indices bucketed by status (counting sort).
+		struct BatchScratch
+		{
+			std::vector<uint8_t> status;
+			std::vector<uint8_t> flags;
+			std::vector<uint32_t> members;
+			std::array<uint32_t, 65> groupStart{};
+
+			void resize(size_t n) {
+				status.resize(n);
+				flags.resize(n);
+				members.resize(n);
+			}
+
+			// Buckets the first n indices whose flag is set by status.
+			void group(size_t n) {
+				groupStart.fill(0);
+				for (size_t i = 0; i < n; ++i) if (flags[i]) ++groupStart[status[i] + 1];
+				for (size_t s = 0; s < 64; ++s) groupStart[s + 1] += groupStart[s];
+				std::array<uint32_t, 64> cursor;
+				std::copy(groupStart.begin(), groupStart.end() - 1, cursor.begin());
+				for (size_t i = 0; i < n; ++i) if (flags[i]) members[cursor[status[i]]++] = static_cast<uint32_t>(i);
+			}
+		};
+
+		thread_local BatchScratch t_scratch;
+	}
+
 	ChessEngine::ChessEngine()
 	{
 	}
@@ -17,6 +86,8 @@ namespace Chess
 	void ChessEngine::specificSetup(const YAML::Node& config)
 	{
 		std::cout << "[ChessEngine] Setup initialized.\n";
+		checkSliderBackendSupport();
+		ActiveSliders::init();
 
 		ZobristHasher::ignoreMetaType(HALF_MOVE);
 		ZobristHasher::ignoreMetaType(FULL_MOVE);
@@ -25,22 +96,6 @@ namespace Chess
 		m_randomOpeningPlies = Core::loadVal<uint32_t>(config["specific"], "randomOpeningPlies", 0u, UINT32_MAX);
 	}
 
-	void ChessEngine::stateToBB(const State& state, StateBB& outStateBB) const
-	{
-		for (size_t i = 0; i < Defs::kMaxElems; ++i)
-		{
-			const auto& f = state.getElem(i);
-			if (f.exists())
-			{
-				if (f.ownerId() == WHITE)
-					outStateBB.whiteBB[f.factId()] |= (1ULL << f.pos());
-				else
-					outStateBB.blackBB[f.factId()] |= (1ULL << f.pos());
-			}
-		}
-		outStateBB.enPassant = static_cast<uint8_t>(state.getMeta(SLOT_EN_PASSANT).value());
-	}
-
 	void ChessEngine::getInitialState(const uint32_t player, State& outState) const
 	{
 		FenParser::getFenState("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", outState);
@@ -71,27 +126,9 @@ namespace Chess
 	ActionList ChessEngine::getValidActions(const State& state, std::span<const uint64_t> hashHistory) const
 	{
 		ActionList actionList{};
-		StateBB stateBB{};
-		stateToBB(state, stateBB);
-
-		bool isWhite = (state.getMeta(SLOT_TURN).ownerId() == WHITE);
-		bool wk = state.getMeta(SLOT_CASTLING_WK).exists();
-		bool wq = state.getMeta(SLOT_CASTLING_WQ).exists();
-		bool bk = state.getMeta(SLOT_CASTLING_BK).exists();
-		bool bq = state.getMeta(SLOT_CASTLING_BQ).exists();
-
-		auto epVal = static_cast<size_t>(state.getMeta(SLOT_EN_PASSANT).pos());
-		bool hasEp = epVal != Defs::kNoPos;
-		stateBB.enPassant = static_cast<uint8_t>(epVal);
-
-		// Bit 0: White, 1: WK, 2: WQ, 3: BK, 4: BQ, 5: HasEP
-		uint8_t status =
-			(isWhite ? 1 : 0) |
-			(wk ? 2 : 0) |
-			(wq ? 4 : 0) |
-			(bk ? 8 : 0) |
-			(bq ? 16 : 0) |
-			(hasEp ? 32 : 0);
+		// Bitboards and status are maintained incrementally in the state's extension block.
+		const StateBB& stateBB = state.ext().bb;
+		const uint8_t status = state.ext().status;
 
 		switch (status)
 		{
@@ -244,29 +281,11 @@ namespace Chess
 	}
 	bool ChessEngine::ourKingInCheck(const State& state) const
 	{
-		StateBB stateBB{};
-		stateToBB(state, stateBB);
-
 		int checkCount = 0;
 
-		bool isWhite = (state.getMeta(SLOT_TURN).ownerId() == WHITE);
-		bool wk = state.getMeta(SLOT_CASTLING_WK).exists();
-		bool wq = state.getMeta(SLOT_CASTLING_WQ).exists();
-		bool bk = state.getMeta(SLOT_CASTLING_BK).exists();
-		bool bq = state.getMeta(SLOT_CASTLING_BQ).exists();
-
-		auto epVal = static_cast<size_t>(state.getMeta(SLOT_EN_PASSANT).pos());
-		bool hasEp = epVal != Defs::kNoPos;
-		stateBB.enPassant = static_cast<uint8_t>(epVal);
-
-		// Bit 0: White, 1: WK, 2: WQ, 3: BK, 4: BQ, 5: HasEP
-		uint8_t status =
-			(isWhite ? 1 : 0) |
-			(wk ? 2 : 0) |
-			(wq ? 4 : 0) |
-			(bk ? 8 : 0) |
-			(bq ? 16 : 0) |
-			(hasEp ? 32 : 0);
+		// Bitboards and status are maintained incrementally in the state's extension block.
+		const StateBB& stateBB = state.ext().bb;
+		const uint8_t status = state.ext().status;
 
 		switch (status)
 		{
@@ -341,20 +360,9 @@ namespace Chess
 	}
 	bool ChessEngine::hasAnyLegalMove(const State& state) const
 	{
-		StateBB stateBB{};
-		stateToBB(state, stateBB);
-
-		bool isWhite = (state.getMeta(SLOT_TURN).ownerId() == WHITE);
-		bool wk = state.getMeta(SLOT_CASTLING_WK).exists();
-		bool wq = state.getMeta(SLOT_CASTLING_WQ).exists();
-		bool bk = state.getMeta(SLOT_CASTLING_BK).exists();
-		bool bq = state.getMeta(SLOT_CASTLING_BQ).exists();
-
-		auto epVal = static_cast<size_t>(state.getMeta(SLOT_EN_PASSANT).pos());
-		bool hasEp = epVal != Defs::kNoPos;
-		stateBB.enPassant = static_cast<uint8_t>(epVal);
-
-		uint8_t status = (isWhite ? 1 : 0) | (wk ? 2 : 0) | (wq ? 4 : 0) | (bk ? 8 : 0) | (bq ? 16 : 0) | (hasEp ? 32 : 0);
+		// Bitboards and status are maintained incrementally in the state's extension block.
+		const StateBB& stateBB = state.ext().bb;
+		const uint8_t status = state.ext().status;
 
 		// Tu peux faire un switch de 0 à 63 comme dans getValidActions
 		switch (status)
@@ -430,10 +438,21 @@ namespace Chess
 	std::optional<GameResult> ChessEngine::getGameResult(
 		const State& state,
 		std::span<const uint64_t> hashHistory) const
+	{
+		if (auto draw = drawByRule(state, hashHistory)) return draw;
+
+		// 5. MAT / PAT (Optimisé sans double génération)
+		if (!hasAnyLegalMove(state)) return noLegalMoveResult(state);
+
+		// La partie continue
+		return std::nullopt;
+	}
+
+	std::optional<GameResult> ChessEngine::drawByRule(
+		const State& state,
+		std::span<const uint64_t> hashHistory) const
 	{
 		constexpr std::array<float, 6> WDL_DRAW = { 0.0f, 1.0f - 0.35f, 0.35f, 0.0f, 1.0f - 0.35f, 0.35f };
-		constexpr std::array<float, 6> WDL_WHITE = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
-		constexpr std::array<float, 6> WDL_BLACK = { 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f };
 
 		// 1. HARD CAP
 		if (hashHistory.size() >= m_maxPly) {
@@ -465,24 +484,78 @@ namespace Chess
 			}
 		}
 
-		// 5. MAT / PAT (Optimisé sans double génération)
-		if (!hasAnyLegalMove(state)) // À implémenter dans ton moteur !
-		{
-			if (!ourKingInCheck(state)) {
-				// Pat
-				return GameResult{ WDL_DRAW, static_cast<uint32_t>(ChessEndReason::Stalemate) };
-			}
+		return std::nullopt;
+	}
 
-			// Mat
-			const bool whiteToMove = (state.getMeta(SLOT_TURN).ownerId() == WHITE);
-			if (whiteToMove)
-				return GameResult{ WDL_BLACK, static_cast<uint32_t>(ChessEndReason::Checkmate) };
-			else
-				return GameResult{ WDL_WHITE, static_cast<uint32_t>(ChessEndReason::Checkmate) };
+	GameResult ChessEngine::noLegalMoveResult(const State& state) const
+	{
+		constexpr std::array<float, 6> WDL_DRAW = { 0.0f, 1.0f - 0.35f, 0.35f, 0.0f, 1.0f - 0.35f, 0.35f };
+		constexpr std::array<float, 6> WDL_WHITE = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+		constexpr std::array<float, 6> WDL_BLACK = { 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f };
+
+		if (!ourKingInCheck(state)) {
+			// Pat
+			return GameResult{ WDL_DRAW, static_cast<uint32_t>(ChessEndReason::Stalemate) };
 		}
 
-		// La partie continue
-		return std::nullopt;
+		// Mat
+		const bool whiteToMove = (state.getMeta(SLOT_TURN).ownerId() == WHITE);
+		if (whiteToMove)
+			return GameResult{ WDL_BLACK, static_cast<uint32_t>(ChessEndReason::Checkmate) };
+		else
+			return GameResult{ WDL_WHITE, static_cast<uint32_t>(ChessEndReason::Checkmate) };
+	}
+
+	void ChessEngine::getValidActionsBatch(
+		std::span<const State* const> states,
+		std::span<const std::span<const uint64_t>> /*hashHistories*/,
+		std::span<ActionList> outActions) const
+	{
+		const size_t n = states.size();
+		BatchScratch& s = t_scratch;
+		s.resize(n);
+
+		for (size_t i = 0; i < n; ++i) {
+			s.status[i] = states[i]->ext().status;
+			s.flags[i] = 1;
+		}
+		s.group(n);
+
+		for (uint32_t st = 0; st < 64; ++st) {
+			const uint32_t begin = s.groupStart[st], end = s.groupStart[st + 1];
+			if (begin != end)
+				kGenerateGroup[st](states.data(), s.members.data() + begin, end - begin, outActions.data());
+		}
+	}
+
+	void ChessEngine::getGameResultBatch(
+		std::span<const State* const> states,
+		std::span<const std::span<const uint64_t>> hashHistories,
+		std::span<std::optional<GameResult>> outResults) const
+	{
+		const size_t n = states.size();
+		BatchScratch& s = t_scratch;
+		s.resize(n);
+
+		// Rule draws first; only the remaining states need a legal-move probe.
+		for (size_t i = 0; i < n; ++i) {
+			outResults[i] = drawByRule(*states[i], hashHistories[i]);
+			s.flags[i] = !outResults[i];
+			s.status[i] = states[i]->ext().status;
+		}
+		s.group(n);
+
+		// Probe results overwrite the flags of the probed states (1 = has a move).
+		for (uint32_t st = 0; st < 64; ++st) {
+			const uint32_t begin = s.groupStart[st], end = s.groupStart[st + 1];
+			if (begin != end)
+				kAnyMoveGroup[st](states.data(), s.members.data() + begin, end - begin, s.flags.data());
+		}
+
+		for (uint32_t k = 0; k < s.groupStart[64]; ++k) {
+			const uint32_t i = s.members[k];
+			if (!s.flags[i]) outResults[i] = noLegalMoveResult(*states[i]);
+		}
 	}
 
 	GameResult ChessEngine::buildResignResult(uint32_t losingPlayer) const
@@ -511,10 +584,7 @@ namespace Chess
 
 	void ChessEngine::changeStatePov(uint32_t viewer, State& outState) const
 	{
-		for (uint32_t idx = 0; idx < Defs::kMaxElems; ++idx)
-		{
-			PovUtils::doRotateOwnerAndMirrorElem(outState, idx, viewer);
-		}
+		PovUtils::doRotateOwnerAndMirrorElems(outState, viewer);
 
 		PovUtils::doRotateOwnerOnlyMeta(outState, SLOT_TURN, viewer);
 
@@ -525,7 +595,7 @@ namespace Chess
 		PovUtils::doRotateOwnerOnlyMeta(outState, SLOT_CASTLING_BQ, viewer);
 
 		// 3. EN-PASSANT : Symétrie sur sa propre case (Slot 5)
-		PovUtils::doRotateOwnerAndMirrorElem(outState, SLOT_EN_PASSANT, viewer);
+		PovUtils::doRotateOwnerAndMirrorMeta(outState, SLOT_EN_PASSANT, viewer);
 	}
 	void ChessEngine::changeActionPov(uint32_t viewer, Action& outAction) const
 	{
@@ -542,19 +612,21 @@ namespace Chess
 		// CORRECTION : On accède au meta via son SLOT
 		const bool isWhiteTurn = (outState.getMeta(SLOT_TURN).ownerId() == WHITE);
 
-		const size_t myStart = isWhiteTurn ? 0 : 16;
-		const size_t myEnd = isWhiteTurn ? 16 : 32;
-		const size_t opStart = isWhiteTurn ? 16 : 0;
-		const size_t opEnd = isWhiteTurn ? 32 : 16;
+		const uint32_t myStart = isWhiteTurn ? 0 : 16;
+		const uint32_t opStart = isWhiteTurn ? 16 : 0;
+
+		// Slot of the element on 'sq' if it belongs to the side starting at 'start', else -1.
+		// The square table lives in the state's extension block (one lookup, no scan).
+		const auto& slotAt = outState.ext().slotAt;
+		auto slotOf = [&slotAt](uint32_t sq, uint32_t start) -> int {
+			if (sq >= Defs::kNumPos) return -1;
+			const uint32_t slot = slotAt[sq];
+			return (slot - start < 16) ? static_cast<int>(slot) : -1;
+		};
 
 		// 2. TROUVER LA PIÈCE DÉPLACÉE
-		int movingIdx = -1;
-		for (uint32_t i = myStart; i < myEnd; ++i) {
-			if (outState.getElem(i).pos() == iFrom) {
-				movingIdx = i;
-				break;
-			}
-		}
+		// An off-board source (e.g. an empty Action) never matches a dead piece.
+		const int movingIdx = slotOf(iFrom, myStart);
 		if (movingIdx == -1) return;
 
 		const auto originalType = outState.getElem(movingIdx).factId();
@@ -576,12 +648,9 @@ namespace Chess
 		}
 
 		// Exécution de la mort de la pièce adverse
-		for (size_t i = opStart; i < opEnd; ++i) {
-			if (outState.getElem(i).pos() == captureSqIdx) {
-				outState.modifyElem(i)->kill();
-				captureOccurred = true;
-				break;
-			}
+		if (const int victim = slotOf(captureSqIdx, opStart); victim != -1) {
+			outState.modifyElem(victim)->kill();
+			captureOccurred = true;
 		}
 
 		// 5. ROQUE
@@ -595,34 +664,30 @@ namespace Chess
 				rookFrom = isWhiteTurn ? A1 : A8;
 				rookTo = isWhiteTurn ? D1 : D8;
 			}
-			for (size_t i = myStart; i < myEnd; ++i) {
-				if (outState.getElem(i).pos() == rookFrom) {
-					outState.modifyElem(i)->setPos(rookTo);
-					break;
-				}
-			}
+			if (const int rook = slotOf(rookFrom, myStart); rook != -1)
+				outState.moveElem(rook, rookTo);
 		}
 
 		// 6. PROMOTION & DÉPLACEMENT PRINCIPAL
-		{
+		// A plain move is a single Zobrist delta; a promotion also changes the piece type.
+		if (!isPawn || promoVal == 0) {
+			outState.moveElem(movingIdx, iTo);
+		}
+		else {
 			auto mutator = outState.modifyElem(movingIdx);
-
-			if (isPawn && promoVal > 0) {
-				uint32_t newPieceType = PAWN;
-
-				// CORRECTION MAGIQUE 2 : Plus de if(isWhiteTurn) ! Le switch est divisé par 2.
-				// La pièce promue garde l'ownerId qu'elle avait déjà.
-				switch (promoVal) {
-				case 1: newPieceType = QUEEN; break;
-				case 2: newPieceType = ROOK; break;
-				case 3: newPieceType = BISHOP; break;
-				case 4: newPieceType = KNIGHT; break;
-				}
-
-				// On utilise le setter qu'on a rajouté plus tôt dans Atom<GT>
-				mutator->setFactId(newPieceType);
+			uint32_t newPieceType = PAWN;
+
+			// CORRECTION MAGIQUE 2 : Plus de if(isWhiteTurn) ! Le switch est divisé par 2.
+			// La pièce promue garde l'ownerId qu'elle avait déjà.
+			switch (promoVal) {
+			case 1: newPieceType = QUEEN; break;
+			case 2: newPieceType = ROOK; break;
+			case 3: newPieceType = BISHOP; break;
+			case 4: newPieceType = KNIGHT; break;
 			}
 
+			// On utilise le setter qu'on a rajouté plus tôt dans Atom<GT>
+			mutator->setFactId(newPieceType);
 			mutator->setPos(iTo);
 		}
 
@@ -685,105 +750,19 @@ namespace Chess
 
 	uint32_t ChessEngine::actionToIdx(const Action& action) const
 	{
-		// 1. Extraction des données depuis le FactT
-		const uint8_t fromIdx = static_cast<uint8_t>(action.source());
-		const uint8_t toIdx = static_cast<uint8_t>(action.dest());
-
-		// Rappel convention : 0=None, 1=Q, 2=R, 3=B, 4=N
-		const int promoVal = static_cast<int>(action.value());
-
-		const int rankFrom = fromIdx / 8;
-		const int fileFrom = fromIdx % 8;
-		const int rankTo = toIdx / 8;
-		const int fileTo = toIdx % 8;
-
-		const int rankDiff = rankTo - rankFrom;
-		const int fileDiff = fileTo - fileFrom;
-
-		// 73 plans par case de départ
-		const uint16_t encodedFrom = fromIdx * 73;
-		uint16_t encodedTo = 0;
-
-		// 2. Logique d'encodage
-		// Convention : Une promotion en Reine (1) est encodée comme un mouvement normal de la Dame.
-		// Seules les sous-promotions (2=R, 3=B, 4=N) vont dans les plans spéciaux.
-		if (promoVal == 0 || promoVal == 1)
-		{
-			// --- A. Sliding Pieces (Queen, Rook, Bishop, Pawn regular, King) ---
-			// Vérifie si c'est un mouvement en ligne droite ou diagonale
-			if ((std::abs(rankDiff) == std::abs(fileDiff)) || (rankDiff == 0) || (fileDiff == 0))
-			{
-				// Nord
-				if (rankDiff > 0 && fileDiff == 0)      encodedTo = 0 + (rankDiff - 1);
-				// Nord-Est
-				else if (rankDiff > 0 && fileDiff > 0)  encodedTo = 7 + (rankDiff - 1);
-				// Est
-				else if (rankDiff == 0 && fileDiff > 0) encodedTo = 14 + (fileDiff - 1);
-				// Sud-Est
-				else if (rankDiff < 0 && fileDiff > 0)  encodedTo = 21 + (fileDiff - 1);
-				// Sud
-				else if (rankDiff < 0 && fileDiff == 0) encodedTo = 28 + (-rankDiff - 1);
-				// Sud-Ouest
-				else if (rankDiff < 0 && fileDiff < 0)  encodedTo = 35 + (-rankDiff - 1);
-				// Ouest
-				else if (rankDiff == 0 && fileDiff < 0) encodedTo = 42 + (-fileDiff - 1);
-				// Nord-Ouest
-				else if (rankDiff > 0 && fileDiff < 0)  encodedTo = 49 + (-fileDiff - 1);
-
-				else throw std::runtime_error("ChessEngine::actionToIdx(): Invalid sliding piece move");
-			}
-			// --- B. Knight Moves ---
-			else if ((std::abs(rankDiff) == 2 && std::abs(fileDiff) == 1) ||
-				(std::abs(rankDiff) == 1 && std::abs(fileDiff) == 2))
-			{
-				if (rankDiff == 2 && fileDiff == 1) encodedTo = 56;
-				else if (rankDiff == 1 && fileDiff == 2) encodedTo = 57;
-				else if (rankDiff == -1 && fileDiff == 2) encodedTo = 58;
-				else if (rankDiff == -2 && fileDiff == 1) encodedTo = 59;
-				else if (rankDiff == -2 && fileDiff == -1) encodedTo = 60;
-				else if (rankDiff == -1 && fileDiff == -2) encodedTo = 61;
-				else if (rankDiff == 1 && fileDiff == -2) encodedTo = 62;
-				else if (rankDiff == 2 && fileDiff == -1) encodedTo = 63;
-
-				else throw std::runtime_error("ChessEngine::actionToIdx(): Invalid knight move");
-			}
-			else
-			{
-				throw std::runtime_error("ChessEngine::actionToIdx(): Invalid piece move (not sliding nor knight)");
-			}
-		}
-		else
-		{
-			// --- C. Underpromotions (Rook, Bishop, Knight) ---
-			// Plans 64 à 72
-
-			// Mapping basé sur votre logique précédente :
-			// Bishop (3) -> 0
-			// Rook   (2) -> 1
-			// Knight (4) -> 2
-			int promoType = 0; // Par défaut Bishop (3)
-			if (promoVal == 2)      promoType = 1; // Rook
-			else if (promoVal == 4) promoType = 2; // Knight
-
-			// Direction de la promotion (Capture gauche, Avance, Capture droite)
-			// Note: Du point de vue absolu (rankDiff), mais fileDiff change selon la capture
-
-			// Avance simple (ex: a7a8)
-			if (std::abs(rankDiff) == 1 && fileDiff == 0)
-				encodedTo = 64 + promoType;
-
-			// Capture diagonale gauche (ex: b7a8 ou b2a1 ?)
-			// Attention : fileDiff = -1 veut dire "vers la gauche" (colonne B -> A)
-			else if (std::abs(rankDiff) == 1 && fileDiff == -1)
-				encodedTo = 67 + promoType;
-
-			// Capture diagonale droite (ex: a7b8)
-			else if (std::abs(rankDiff) == 1 && fileDiff == 1)
-				encodedTo = 70 + promoType;
+		// Same map the move generator tags its moves with (PolicyIndex.hpp).
+		// Convention : promo 0=None, 1=Q, 2=R, 3=B, 4=N ; a queen promotion is
+		// encoded as a plain queen-like move, only underpromotions get their own planes.
+		const uint32_t fromIdx = action.source();
+		const uint32_t toIdx = action.dest();
+		const uint32_t promoVal = static_cast<uint32_t>(action.value());
 
-			else throw std::runtime_error("ChessEngine::actionToIdx(): Invalid promotion move");
-		}
+		if (fromIdx >= 64 || toIdx >= 64)
+			throw std::runtime_error("ChessEngine::actionToIdx(): Move outside the board");
 
-		return static_cast<uint32_t>(encodedFrom + encodedTo);
+		const uint32_t idx = policyIndex(fromIdx, toIdx, promoVal);
+		if (idx == kNoPolicyIdx)
+			throw std::runtime_error("ChessEngine::actionToIdx(): Move not representable in the policy encoding");
+		return idx;
 	}
 }
\ No newline at end of file
@@ -5,7 +5,8 @@
 
 namespace Chess
 {
-    class ChessEngine : public Core::IEngine<ChessTypes>
+    // final: lets the search core bind to this type without virtual dispatch.
+    class ChessEngine final : public Core::IEngine<ChessTypes>
     {
     public:
         USING_GAME_TYPES(ChessTypes);
@@ -15,7 +16,10 @@ namespace Chess
         uint32_t m_randomOpeningPlies = 0;
 
     private:
-        void stateToBB(const State& state, StateBB& out) const;
+        // Terminal checks that need no move generation (ply cap, 50 moves,
+        // material, repetition), and the result once no legal move is left.
+        std::optional<GameResult> drawByRule(const State& state, std::span<const uint64_t> hashHistory) const;
+        GameResult noLegalMoveResult(const State& state) const;
 
         bool isFiftyMoveRule(const State& state) const;
         bool isInsufficientMaterial(const State& state) const;
@@ -42,5 +46,12 @@ namespace Chess
         void applyAction(const Action& action, State& outState) const override;
 
         uint32_t actionToIdx(const Action& action) const override;
+
+        // Batches are grouped by MoveGenerator<Status> specialization.
+        void getValidActionsBatch(std::span<const State* const> states,
+            std::span<const std::span<const uint64_t>> hashHistories, std::span<ActionList> outActions) const override;
+        void getGameResultBatch(std::span<const State* const> states,
+            std::span<const std::span<const uint64_t>> hashHistories,
+            std::span<std::optional<GameResult>> outResults) const override;
     };
 }
\ No newline at end of file
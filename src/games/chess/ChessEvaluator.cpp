@@ -0,0 +1,186 @@
+#include "ChessEvaluator.hpp"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+namespace Chess
+{
+	USING_GAME_TYPES(ChessTypes);
+
+	namespace
+	{
+		constexpr int kPieceValue[6] = { 100, 320, 330, 500, 900, 0 };
+		constexpr int kPhaseWeight[6] = { 0, 1, 1, 2, 4, 0 };
+		constexpr int kMaxPhase = 24;
+
+		// Tables are written as seen from White with rank 8 on top:
+		// White reads index (sq ^ 56), Black reads index sq.
+		constexpr int kPst[6][64] =
+		{
+			{ // PAWN
+				  0,  0,  0,  0,  0,  0,  0,  0,
+				 50, 50, 50, 50, 50, 50, 50, 50,
+				 10, 10, 20, 30, 30, 20, 10, 10,
+				  5,  5, 10, 25, 25, 10,  5,  5,
+				  0,  0,  0, 20, 20,  0,  0,  0,
+				  5, -5,-10,  0,  0,-10, -5,  5,
+				  5, 10, 10,-20,-20, 10, 10,  5,
+				  0,  0,  0,  0,  0,  0,  0,  0
+			},
+			{ // KNIGHT
+				-50,-40,-30,-30,-30,-30,-40,-50,
+				-40,-20,  0,  0,  0,  0,-20,-40,
+				-30,  0, 10, 15, 15, 10,  0,-30,
+				-30,  5, 15, 20, 20, 15,  5,-30,
+				-30,  0, 15, 20, 20, 15,  0,-30,
+				-30,  5, 10, 15, 15, 10,  5,-30,
+				-40,-20,  0,  5,  5,  0,-20,-40,
+				-50,-40,-30,-30,-30,-30,-40,-50
+			},
+			{ // BISHOP
+				-20,-10,-10,-10,-10,-10,-10,-20,
+				-10,  0,  0,  0,  0,  0,  0,-10,
+				-10,  0,  5, 10, 10,  5,  0,-10,
+				-10,  5,  5, 10, 10,  5,  5,-10,
+				-10,  0, 10, 10, 10, 10,  0,-10,
+				-10, 10, 10, 10, 10, 10, 10,-10,
+				-10,  5,  0,  0,  0,  0,  5,-10,
+				-20,-10,-10,-10,-10,-10,-10,-20
+			},
+			{ // ROOK
+				  0,  0,  0,  0,  0,  0,  0,  0,
+				  5, 10, 10, 10, 10, 10, 10,  5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				 -5,  0,  0,  0,  0,  0,  0, -5,
+				  0,  0,  0,  5,  5,  0,  0,  0
+			},
+			{ // QUEEN
+				-20,-10,-10, -5, -5,-10,-10,-20,
+				-10,  0,  0,  0,  0,  0,  0,-10,
+				-10,  0,  5,  5,  5,  5,  0,-10,
+				 -5,  0,  5,  5,  5,  5,  0, -5,
+				  0,  0,  5,  5,  5,  5,  0, -5,
+				-10,  5,  5,  5,  5,  5,  0,-10,
+				-10,  0,  5,  0,  0,  0,  0,-10,
+				-20,-10,-10, -5, -5,-10,-10,-20
+			},
+			{ // KING (middlegame)
+				-30,-40,-40,-50,-50,-40,-40,-30,
+				-30,-40,-40,-50,-50,-40,-40,-30,
+				-30,-40,-40,-50,-50,-40,-40,-30,
+				-30,-40,-40,-50,-50,-40,-40,-30,
+				-20,-30,-30,-40,-40,-30,-30,-20,
+				-10,-20,-20,-20,-20,-20,-20,-10,
+				 20, 20,  0,  0,  0,  0, 20, 20,
+				 20, 30, 10,  0,  0, 10, 30, 20
+			}
+		};
+
+		constexpr int kKingEndgame[64] =
+		{
+			-50,-40,-30,-20,-20,-30,-40,-50,
+			-30,-20,-10,  0,  0,-10,-20,-30,
+			-30,-10, 20, 30, 30, 20,-10,-30,
+			-30,-10, 30, 40, 40, 30,-10,-30,
+			-30,-10, 30, 40, 40, 30,-10,-30,
+			-30,-10, 20, 30, 30, 20,-10,-30,
+			-30,-30,  0,  0,  0,  0,-30,-30,
+			-50,-30,-30,-30,-30,-30,-30,-50
+		};
+
+		// Promotion encoding in Action::value(): 0=None, 1=Q, 2=R, 3=B, 4=N
+		constexpr int kPromoGain[5] = { 0, 800, 400, 230, 220 };
+	}
+
+	void ChessEvaluator::specificSetup(const YAML::Node& config)
+	{
+		std::cout << "[ChessEvaluator] Setup initialized.\n";
+
+		if (config["specific"] && config["specific"]["heuristicCaptureBias"])
+			m_captureBias = Core::loadVal<float>(config["specific"], "heuristicCaptureBias", 0.0f, 100.0f);
+	}
+
+	void ChessEvaluator::evaluate(const State& state, uint32_t viewer, const ActionList& validActions,
+		std::array<float, Defs::kNumPlayers * 3>& wdl, std::span<float> actionLogits) const
+	{
+		// Mailbox: piece type + 1 (0 = empty), and owner per square.
+		uint8_t board[64] = {};
+		uint8_t owner[64] = {};
+
+		int mg[2] = { 0, 0 };
+		int kingSq[2] = { -1, -1 };
+		int phase = 0;
+
+		for (uint32_t i = 0; i < Defs::kMaxElems; ++i)
+		{
+			const auto& f = state.getElem(i);
+			if (!f.exists()) continue;
+
+			const uint32_t type = f.factId();
+			const uint32_t side = f.ownerId();
+			const uint32_t sq = f.pos();
+			if (type > KING || side > BLACK || sq >= 64) continue;
+
+			board[sq] = static_cast<uint8_t>(type + 1);
+			owner[sq] = static_cast<uint8_t>(side);
+
+			const uint32_t pstIdx = (side == WHITE) ? (sq ^ 56) : sq;
+			phase += kPhaseWeight[type];
+
+			if (type == KING) kingSq[side] = static_cast<int>(pstIdx);
+			else mg[side] += kPieceValue[type] + kPst[type][pstIdx];
+		}
+
+		// King safety fades out and centralization fades in as material leaves the board.
+		const float mgWeight = static_cast<float>(std::min(phase, kMaxPhase)) / kMaxPhase;
+		float score[2];
+		for (uint32_t s = 0; s < 2; ++s) {
+			score[s] = static_cast<float>(mg[s]);
+			if (kingSq[s] >= 0)
+				score[s] += mgWeight * kPst[KING][kingSq[s]] + (1.0f - mgWeight) * kKingEndgame[kingSq[s]];
+		}
+
+		const uint32_t me = viewer;
+		const uint32_t opp = 1 - viewer;
+		const float cp = score[me] - score[opp];
+
+		// Expected score E = W + D/2, with D largest for balanced positions.
+		const float e = 1.0f / (1.0f + std::exp(-cp / kScaleCp));
+		const float d = kDrawMax * (1.0f - std::abs(2.0f * e - 1.0f));
+		const float w = std::max(0.0f, e - 0.5f * d);
+		const float l = std::max(0.0f, 1.0f - e - 0.5f * d);
+
+		wdl[0] = w; wdl[1] = d; wdl[2] = l;  // Side to move
+		wdl[3] = l; wdl[4] = d; wdl[5] = w;  // Opponent (mirror)
+
+		// Policy logits: flat, plus MVV-LVA for captures and promotion gain.
+		for (size_t i = 0; i < validActions.size(); ++i)
+		{
+			float logit = 0.0f;
+			if (m_captureBias > 0.0f)
+			{
+				const Action& a = validActions[i];
+				const uint32_t from = a.source();
+				const uint32_t to = a.dest();
+				const int mover = (from < 64 && board[from]) ? board[from] - 1 : static_cast<int>(PAWN);
+
+				int victim = -1;
+				if (to < 64 && board[to] && owner[to] == opp) victim = board[to] - 1;
+				else if (mover == PAWN && to < 64 && (from % 8) != (to % 8)) victim = PAWN; // En passant
+
+				int gain = 0;
+				if (victim >= 0) gain += kPieceValue[victim] - kPieceValue[mover] / 10;
+
+				const uint32_t promo = static_cast<uint32_t>(a.value());
+				if (promo < 5) gain += kPromoGain[promo];
+
+				logit = m_captureBias * static_cast<float>(std::max(gain, 0)) / 100.0f;
+			}
+			actionLogits[i] = logit;
+		}
+	}
+}
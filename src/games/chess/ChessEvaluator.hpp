@@ -0,0 +1,37 @@
+#pragma once
+#include "../../corelib/interfaces/IEvaluator.hpp"
+#include "ChessTypes.hpp"
+
+namespace Chess
+{
+	// ========================================================================
+	// CHESS HEURISTIC EVALUATOR
+	// Material + piece-square tables (Simplified Evaluation Function values),
+	// with the king table blended between middlegame and endgame by phase.
+	// The centipawn score maps to WDL through a logistic expected score and a
+	// draw band that widens for balanced positions.
+	//
+	// Policy: uniform over legal moves, plus an optional MVV-LVA bonus for
+	// captures and promotions (specific.heuristicCaptureBias, 0 = uniform).
+	// ========================================================================
+	class ChessEvaluator : public Core::IEvaluator<ChessTypes>
+	{
+	public:
+		USING_GAME_TYPES(ChessTypes);
+
+	private:
+		static constexpr float kScaleCp = 270.0f; // Centipawns per logistic unit
+		static constexpr float kDrawMax = 0.40f;  // Draw mass at an even score
+
+		float m_captureBias = 1.0f;
+
+	protected:
+		void specificSetup(const YAML::Node& config) override;
+
+	public:
+		ChessEvaluator() = default;
+
+		void evaluate(const State& state, uint32_t viewer, const ActionList& validActions,
+			std::array<float, Defs::kNumPlayers * 3>& wdl, std::span<float> actionLogits) const override;
+	};
+}
@@ -4,6 +4,7 @@
 #include "ChessEngine.hpp"
 #include "ChessRequester.hpp"
 #include "ChessRenderer.hpp"
+#include "ChessEvaluator.hpp"
 #include "UCIHandler.hpp"
 #include "../../src/corelib/handlers/InferenceHandler.hpp"
 
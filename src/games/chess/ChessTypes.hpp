@@ -1,10 +1,14 @@
 #pragma once
+#include <array>
+#include <cstdint>
 
 namespace Chess
 {
+    struct ChessStateExt;
     class ChessEngine;
     class ChessRequester;
     class ChessRenderer;
+    class ChessEvaluator;
     class UCIHandler;
 
     struct ChessTypes
@@ -42,10 +46,15 @@ namespace Chess
         // Action space for the neural network (8x8 x 73 plans)
         static constexpr uint32_t kActionSpace = 4672;
 
+        // 128-bit Zobrist keys (State::hash128) for sharing positions across games
+        static constexpr bool kWideHash = true;
+
         using GameTypes = ChessTypes;
+        using StateExt = ChessStateExt;
         using Engine = ChessEngine;
         using Requester = ChessRequester;
         using Renderer = ChessRenderer;
+        using Evaluator = ChessEvaluator;
         using Handler = UCIHandler;
     };
 
@@ -107,4 +116,67 @@ namespace Chess
         MaxPlyReached = 6,       // Limite de profondeur atteinte (pour les parties longues),
 		Resigned = 7             // Résignation
     };
+
+    struct StateBB
+    {
+        uint64_t whiteBB[6]; // P, N, B, R, Q, K
+        uint64_t blackBB[6]; // P, N, B, R, Q, K
+        uint8_t enPassant;
+    };
+
+    // ========================================================================
+    // BITBOARD EXTENSION BLOCK
+    // Carried by every Core::State<ChessTypes> and updated by its fact mutators
+    // (see Core::StateExtOf), so move generation reads bitboards and the
+    // MoveGenerator<Status> index straight from the state instead of rebuilding
+    // them from the 32 piece facts.
+    // Every contribution is an XOR: pieces toggle their square bit, metas toggle
+    // their status bit, and the en-passant square is stored relative to 64
+    // (64 = none, as MoveGenerator expects). The square -> element slot table
+    // is stored relative to kNoSlot the same way.
+    // ========================================================================
+    struct ChessStateExt
+    {
+        static constexpr uint8_t kNoEpSquare = 64;
+        static constexpr uint8_t kNoSlot = 0xFF;
+
+        StateBB bb{ {}, {}, kNoEpSquare };
+        uint8_t status = 0; // Bit 0: White, 1: WK, 2: WQ, 3: BK, 4: BQ, 5: HasEP
+        std::array<uint8_t, 64> slotAt = emptyBoard();  // Element slot on each square, kNoSlot if empty
+
+        static constexpr std::array<uint8_t, 64> emptyBoard() noexcept {
+            std::array<uint8_t, 64> a{};
+            a.fill(kNoSlot);
+            return a;
+        }
+
+        template<typename F>
+        constexpr void toggle(uint32_t factIdx, const F& f) noexcept
+        {
+            const uint32_t p = f.pos();
+
+            if (factIdx < ChessTypes::kMaxElems) {
+                if (p < ChessTypes::kNumPos) {
+                    (f.ownerId() == WHITE ? bb.whiteBB : bb.blackBB)[f.factId()] ^= (1ULL << p);
+                    slotAt[p] ^= static_cast<uint8_t>(factIdx ^ kNoSlot);
+                }
+                return;
+            }
+
+            switch (factIdx - ChessTypes::kMaxElems) {
+            case SLOT_TURN:        if (f.ownerId() == WHITE) status ^= 1;  break;
+            case SLOT_CASTLING_WK: if (f.exists()) status ^= 2;  break;
+            case SLOT_CASTLING_WQ: if (f.exists()) status ^= 4;  break;
+            case SLOT_CASTLING_BK: if (f.exists()) status ^= 8;  break;
+            case SLOT_CASTLING_BQ: if (f.exists()) status ^= 16; break;
+            case SLOT_EN_PASSANT:
+                if (p < ChessTypes::kNumPos) {
+                    status ^= 32;
+                    bb.enPassant ^= static_cast<uint8_t>(p ^ kNoEpSquare);
+                }
+                break;
+            default: break;
+            }
+        }
+    };
 }
\ No newline at end of file
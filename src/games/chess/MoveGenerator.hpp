@@ -3,16 +3,12 @@
 #include <cstring>
 
 #include "ChessTypes.hpp"
-#include "Tables.hpp"
+#include "PolicyIndex.hpp"
+#include "SliderAttacks.hpp"
 #include "../../corelib/util/CompilerHints.hpp"
 
 namespace Chess
 {
-    using map = uint64_t;
-
-    // initialisation compile‑time des magic tables
-    alignas(64) static constexpr Tables tables{};
-
     static constexpr map FILE_A = 0x0101010101010101ULL;
     static constexpr map FILE_H = 0x8080808080808080ULL;
     static constexpr map RANK_1 = 0x00000000000000FFULL;
@@ -37,13 +33,6 @@ namespace Chess
         return -((x | -x) >> 63);
     }
 
-    struct StateBB
-    {
-        uint64_t whiteBB[6]; // P, N, B, R, Q, K
-        uint64_t blackBB[6]; // P, N, B, R, Q, K
-        uint8_t enPassant;
-    };
-
     template<uint8_t Status>
     struct BoardStatusFor
     {
@@ -56,7 +45,8 @@ namespace Chess
     };
 
     // isWhite[0], castlingRights[1-4], enPassant[5]
-    template<uint8_t StatusFlag>
+    // Sliders: bishop/rook attack backend (SliderAttacks.hpp), the build's choice by default.
+    template<uint8_t StatusFlag, typename Sliders = ActiveSliders>
     class MoveGenerator
     {
     private:
@@ -132,8 +122,7 @@ namespace Chess
             while (tmp)
             {
                 int sq = popLSB(tmp);
-                int idx = (int)(((occWOK & tables.bishopMasks[sq]) * tables.bishopMagicNumbers[sq]) >> tables.bishopShifts[sq]);
-                atk |= tables.bishopAttacks[tables.bishopOffsets[sq] + idx];
+                atk |= Sliders::bishop(sq, occWOK);
             }
 
             // tours & dames orthogonaux
@@ -141,8 +130,7 @@ namespace Chess
             while (tmp)
             {
                 int sq = popLSB(tmp);
-                int idx = (int)(((occWOK & tables.rookMasks[sq]) * tables.rookMagicNumbers[sq]) >> tables.rookShifts[sq]);
-                atk |= tables.rookAttacks[tables.rookOffsets[sq] + idx];
+                atk |= Sliders::rook(sq, occWOK);
             }
 
             // roi adverse (un seul bit)
@@ -175,16 +163,10 @@ namespace Chess
 
             // Sliders Pieces
             // Bishops & Queens
-            int bishopIdx = (int)(((b.oppOcc & tables.bishopMasks[kingSq])
-                * tables.bishopMagicNumbers[kingSq])
-                >> tables.bishopShifts[kingSq]);
-            map bishopAtk = tables.bishopAttacks[tables.bishopOffsets[kingSq] + bishopIdx];
+            map bishopAtk = Sliders::bishop(kingSq, b.oppOcc);
 
             // Rooks & Queens
-            int rookIdx = (int)(((b.oppOcc & tables.rookMasks[kingSq])
-                * tables.rookMagicNumbers[kingSq])
-                >> tables.rookShifts[kingSq]);
-            map rookAtk = tables.rookAttacks[tables.rookOffsets[kingSq] + rookIdx];
+            map rookAtk = Sliders::rook(kingSq, b.oppOcc);
 
             // Slider Checkers with no enemy pieces between
             map bishopCheckers = bishopAtk & (b.oppBishop | b.oppQueen);
@@ -236,7 +218,7 @@ namespace Chess
             return tables.rayBetween[index];
         }
 
-        // Add legal moves
+        // Add legal moves, each tagged with its policy index (PolicyIndex.hpp)
         static ALWAYS_INLINE
             void addLegalMoves(ActionList& actionList, uint8_t pieceId, int pieceSquare, map pieceMask, map promo) noexcept
         {
@@ -251,13 +233,13 @@ namespace Chess
                     for (int i = 1; i < 5; ++i)
                     {
                         action.configure(pieceId, ownerId, pieceSquare, to, static_cast<float>(i));
-                        actionList.push_back(action);
+                        actionList.push_back(action, policyIndex(pieceSquare, to, i));
                     }
                 }
                 else
                 {
                     action.configure(pieceId, ownerId, pieceSquare, to, 0.0f);
-                    actionList.push_back(action);
+                    actionList.push_back(action, policyIndexMap.move[pieceSquare * 64 + to]);
                 }
             }
         }
@@ -416,8 +398,7 @@ namespace Chess
             tmp = b.ourBishop | b.ourQueen;
             while (tmp) {
                 int sq = popLSB(tmp);
-                int idx = (int)(((b.occ & tables.bishopMasks[sq]) * tables.bishopMagicNumbers[sq]) >> tables.bishopShifts[sq]);
-                map atk = tables.bishopAttacks[tables.bishopOffsets[sq] + idx] & (~b.ourOcc) & checkMask;
+                map atk = Sliders::bishop(sq, b.occ) & (~b.ourOcc) & checkMask;
                 if (atk & getPinRay(pinnerOf, kingSq, sq)) return true;
             }
 
@@ -425,8 +406,7 @@ namespace Chess
             tmp = b.ourRook | b.ourQueen;
             while (tmp) {
                 int sq = popLSB(tmp);
-                int idx = (int)(((b.occ & tables.rookMasks[sq]) * tables.rookMagicNumbers[sq]) >> tables.rookShifts[sq]);
-                map atk = tables.rookAttacks[tables.rookOffsets[sq] + idx] & (~b.ourOcc) & checkMask;
+                map atk = Sliders::rook(sq, b.occ) & (~b.ourOcc) & checkMask;
                 if (atk & getPinRay(pinnerOf, kingSq, sq)) return true;
             }
 
@@ -649,10 +629,7 @@ namespace Chess
                 while (tmp)
                 {
                     int bishopSq = popLSB(tmp);
-                    int bishopIdx = (int)(((b.occ & tables.bishopMasks[bishopSq])
-                        * tables.bishopMagicNumbers[bishopSq])
-                        >> tables.bishopShifts[bishopSq]);
-                    map bishopAtk = tables.bishopAttacks[tables.bishopOffsets[bishopSq] + bishopIdx]
+                    map bishopAtk = Sliders::bishop(bishopSq, b.occ)
                         & (~b.ourOcc) & checkMask;
 
                     map pinRay = getPinRay(pinnerOf, kingSq, bishopSq);
@@ -668,10 +645,7 @@ namespace Chess
                 while (tmp)
                 {
                     int rookSq = popLSB(tmp);
-                    int rookIdx = (int)(((b.occ & tables.rookMasks[rookSq])
-                        * tables.rookMagicNumbers[rookSq])
-                        >> tables.rookShifts[rookSq]);
-                    map rookAtk = tables.rookAttacks[tables.rookOffsets[rookSq] + rookIdx]
+                    map rookAtk = Sliders::rook(rookSq, b.occ)
                         & (~b.ourOcc) & checkMask;
 
                     map pinRay = getPinRay(pinnerOf, kingSq, rookSq);
@@ -3,9 +3,25 @@
 #include <iostream>
 #include <cstring>
 #include <span>
+#include <array>
+#include <utility>
 
 namespace Chess
 {
+    namespace
+    {
+        USING_GAME_TYPES(ChessTypes);
+
+        using GenerateMovesFn = void(*)(const StateBB&, ActionList&);
+
+        // One entry per MoveGenerator<Status, Sliders> specialization, indexed by status.
+        template<typename Sliders, size_t... S>
+        constexpr std::array<GenerateMovesFn, 64> makeGenerateTable(std::index_sequence<S...>)
+        {
+            return { &MoveGenerator<static_cast<uint8_t>(S), Sliders>::generate... };
+        }
+    }
+
     PerftTool::PerftTool()
     {
     }
@@ -14,7 +30,8 @@ namespace Chess
     {
     }
 
-    uint64_t PerftTool::perft(const State& root, int maxDepth)
+    template<typename GenerateFn>
+    uint64_t PerftTool::perftLoop(const State& root, int maxDepth, GenerateFn&& generate)
     {
         if (maxDepth <= 0) return 1ULL; // Convention Perft : D=0 vaut 1 nœud (la racine)
 
@@ -31,9 +48,7 @@ namespace Chess
         // --- Initialisation racine ---
         states[0] = root;
 
-        // NOUVELLE API : On passe un span vide pour l'historique des hashs pendant un Perft !
-        std::span<const uint64_t> emptyHistory{};
-        actions[0] = m_engine->getValidActions(states[0], emptyHistory);
+        generate(states[0], actions[0]);
 
         // Optimisation extrême : Si on demande D=1, on renvoie juste la taille
         if (D == 1) return actions[0].size();
@@ -58,8 +73,7 @@ namespace Chess
                 // 4) On descend d'un niveau
                 ++depth;
 
-                // NOUVELLE API : Span vide pour ignorer l'historique
-                actions[depth] = m_engine->getValidActions(states[depth], emptyHistory);
+                generate(states[depth], actions[depth]);
 
                 // ==========================================================
                 // LA MAGIE DU BULK COUNTING
@@ -88,6 +102,25 @@ namespace Chess
         return nodes;
     }
 
+    uint64_t PerftTool::perft(const State& root, int maxDepth)
+    {
+        // NOUVELLE API : On passe un span vide pour l'historique des hashs pendant un Perft !
+        std::span<const uint64_t> emptyHistory{};
+        return perftLoop(root, maxDepth, [this, emptyHistory](const State& state, ActionList& out) {
+            out = m_engine->getValidActions(state, emptyHistory);
+        });
+    }
+
+    template<typename Sliders>
+    uint64_t PerftTool::perftWith(const State& root, int maxDepth)
+    {
+        static constexpr auto kGenerate = makeGenerateTable<Sliders>(std::make_index_sequence<64>{});
+        return perftLoop(root, maxDepth, [](const State& state, ActionList& out) {
+            out.clear();
+            kGenerate[state.ext().status](state.ext().bb, out);
+        });
+    }
+
     void PerftTool::runNormal(const Vec<PerftTest>& normalTests)
     {
         int nameSpaces = 0;
@@ -183,4 +216,54 @@ namespace Chess
             }
         }
     }
+
+    void PerftTool::runSliderBench(const Vec<PerftTest>& benchTests)
+    {
+        // Backend name, and its perft entry point.
+        using BenchFn = uint64_t(PerftTool::*)(const State&, int);
+        const std::pair<const char*, BenchFn> backends[] = {
+            { MagicSliders::kName, &PerftTool::perftWith<MagicSliders> },
+            { FancySliders::kName, &PerftTool::perftWith<FancySliders> },
+#ifdef ONEMINDARMY_CHESS_HAS_PEXT
+            { PextSliders::kName, &PerftTool::perftWith<PextSliders> },
+#endif
+        };
+
+        FancySliders::init();
+#ifdef ONEMINDARMY_CHESS_HAS_PEXT
+        PextSliders::init();
+#endif
+
+        std::cout << "[SliderBench] active backend: " << ActiveSliders::kName
+            << " | fancy table: " << FancySliders::data.used << " entries ("
+            << FancySliders::data.used * sizeof(map) / 1024 << " KB)\n";
+
+        for (const auto& [name, fn] : backends)
+        {
+            uint64_t totalNodes = 0;
+            double totalMs = 0.0;
+            bool pass = true;
+
+            for (auto const& t : benchTests)
+            {
+                State state;
+                FenParser::getFenState(t.fen, state);
+
+                auto t0 = std::chrono::high_resolution_clock::now();
+                uint64_t nodes = (this->*fn)(state, t.depth);
+                auto t1 = std::chrono::high_resolution_clock::now();
+
+                totalMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+                totalNodes += nodes;
+                pass = pass && (t.expected == 0 || nodes == t.expected);
+            }
+
+            std::cout << "[SliderBench] " << name
+                << " nodes=" << totalNodes
+                << " time=" << totalMs << "ms"
+                << " nps=" << static_cast<uint64_t>(totalMs > 0.0 ? totalNodes / (totalMs / 1000.0) : 0.0)
+                << (pass ? " [PASS]" : " [FAIL]") << "\n";
+        }
+        std::cout << "Finished!" << std::endl;
+    }
 }
\ No newline at end of file
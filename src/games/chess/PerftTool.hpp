@@ -34,13 +34,26 @@ namespace Chess
         };
         static constexpr const char* kPromosLetter[5] = { "", "q", "r", "b", "n" };
 
+        // Iterative bulk-counting DFS shared by every perft flavour; 'generate'
+        // fills the legal moves of a state.
+        template<typename GenerateFn>
+        uint64_t perftLoop(const State& root, int maxDepth, GenerateFn&& generate);
+
     public:
         PerftTool();
         PerftTool(std::shared_ptr<ChessEngine> engine);
 
         uint64_t perft(const State& root, int maxDepth);
 
+        // Same count, generating through MoveGenerator<Status, Sliders> directly,
+        // so any slider backend of the build can be timed (not just the active one).
+        template<typename Sliders>
+        uint64_t perftWith(const State& root, int maxDepth);
+
         void runNormal(const Vec<PerftTest>& normalTests);
         void runDivide(const Vec<PerftTest>& divideTests);
+
+        // Times every test under each slider backend available in this build.
+        void runSliderBench(const Vec<PerftTest>& benchTests);
     };
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+
+namespace Chess
+{
+    // ============================================================================
+    // POLICY INDEX MAP
+    // (from, to, promo) -> flat index into the network's policy head, laid out
+    // as 73 planes per origin square: index = from * 73 + plane.
+    //   planes  0..55 : queen-like moves, 7 distances in each of 8 directions
+    //                   (N, NE, E, SE, S, SW, W, NW). Covers king, pawn pushes
+    //                   and captures, castling (king two squares sideways) and
+    //                   queen promotions.
+    //   planes 56..63 : knight jumps.
+    //   planes 64..72 : underpromotions, 3 pieces (B, R, N) for each of push,
+    //                   capture toward file a, capture toward file h.
+    //
+    // Design Intent:
+    // The (from, to) part is a compile-time table (8 KB), so the move generator
+    // tags each move it emits with one load; underpromotions, rare and always
+    // one rank away, are two small lookups on top. ChessEngine::actionToIdx
+    // reads the same map, so both paths agree by construction.
+    // ============================================================================
+    inline constexpr uint16_t kNoPolicyIdx = 0xFFFF;
+
+    struct PolicyIndexMap
+    {
+        // Index of a non-promoting (or queen-promoting) move, kNoPolicyIdx if no
+        // piece moves that way. Indexed [from * 64 + to].
+        uint16_t move[64 * 64];
+
+        constexpr PolicyIndexMap() : move{}
+        {
+            // Direction planes in N, NE, E, SE, S, SW, W, NW order, by (sign(dr), sign(df)).
+            constexpr int kQueenDir[3][3] = {
+                { 5, 4, 3 },    // dr < 0: SW, S, SE
+                { 6, -1, 2 },   // dr = 0: W, -, E
+                { 7, 0, 1 },    // dr > 0: NW, N, NE
+            };
+            // Knight planes by (dr + 2, df + 2).
+            constexpr int kKnightPlane[5][5] = {
+                { -1, 60, -1, 59, -1 },
+                { 61, -1, -1, -1, 58 },
+                { -1, -1, -1, -1, -1 },
+                { 62, -1, -1, -1, 57 },
+                { -1, 63, -1, 56, -1 },
+            };
+
+            for (int from = 0; from < 64; ++from) {
+                for (int to = 0; to < 64; ++to) {
+                    const int dr = to / 8 - from / 8;
+                    const int df = to % 8 - from % 8;
+                    const int adr = dr < 0 ? -dr : dr;
+                    const int adf = df < 0 ? -df : df;
+
+                    int plane = -1;
+                    if (from != to && (dr == 0 || df == 0 || adr == adf)) {
+                        const int dist = adr > adf ? adr : adf;
+                        plane = kQueenDir[(dr > 0) - (dr < 0) + 1][(df > 0) - (df < 0) + 1] * 7 + (dist - 1);
+                    }
+                    else if (adr <= 2 && adf <= 2) {
+                        plane = kKnightPlane[dr + 2][df + 2];
+                    }
+                    move[from * 64 + to] = plane < 0 ? kNoPolicyIdx : static_cast<uint16_t>(from * 73 + plane);
+                }
+            }
+        }
+    };
+
+    alignas(64) inline constexpr PolicyIndexMap policyIndexMap{};
+
+    // promo follows Action::value(): 0 = none, 1 = Q, 2 = R, 3 = B, 4 = N.
+    // Returns kNoPolicyIdx for moves the encoding cannot represent.
+    [[nodiscard]] constexpr uint16_t policyIndex(uint32_t from, uint32_t to, uint32_t promo) noexcept
+    {
+        if (promo <= 1) return policyIndexMap.move[from * 64 + to];
+
+        // Underpromotion plane = 64 + 3 * direction + piece.
+        constexpr uint8_t kPiece[5] = { 0, 0, 1, 0, 2 };   // R -> 1, B -> 0, N -> 2
+        constexpr uint8_t kDirection[3] = { 1, 0, 2 };     // by df + 1: toward a, push, toward h
+        const int dr = static_cast<int>(to / 8) - static_cast<int>(from / 8);
+        const int df = static_cast<int>(to % 8) - static_cast<int>(from % 8);
+        if (promo > 4 || (dr != 1 && dr != -1) || df < -1 || df > 1) return kNoPolicyIdx;
+        return static_cast<uint16_t>(from * 73 + 64 + 3 * kDirection[df + 1] + kPiece[promo]);
+    }
+}
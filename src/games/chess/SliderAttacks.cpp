@@ -0,0 +1,135 @@
+#include "SliderAttacks.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Chess
+{
+    namespace
+    {
+        // One square's table under the startup-built magics: (index, attacks) for
+        // every index some occupancy maps to. Unlisted indices are free slots.
+        struct MagicSubTable
+        {
+            std::vector<std::pair<uint32_t, map>> entries;
+            uint32_t size = 0;
+        };
+
+        template<typename AttackFn>
+        MagicSubTable collect(map mask, map magic, int shift, AttackFn attacks)
+        {
+            MagicSubTable t;
+            t.size = 1u << (64 - shift);
+            std::vector<uint8_t> seen(t.size, 0);
+
+            // Carry-rippler: walks every subset of 'mask', the empty one included.
+            map occ = 0;
+            do {
+                const uint32_t idx = (uint32_t)((occ * magic) >> shift);
+                if (!seen[idx]) {
+                    seen[idx] = 1;
+                    t.entries.emplace_back(idx, attacks(occ));
+                }
+                occ = (occ - mask) & mask;
+            } while (occ);
+
+            std::sort(t.entries.begin(), t.entries.end());
+            return t;
+        }
+
+        // First-fit placement into the shared array: the lowest offset where every
+        // entry lands on a free slot or on an equal value.
+        uint32_t place(const MagicSubTable& t, map* attacks, std::vector<uint8_t>& taken, uint32_t& used)
+        {
+            for (uint32_t offset = 0;; ++offset) {
+                bool fits = true;
+                for (const auto& [idx, value] : t.entries) {
+                    const uint32_t slot = offset + idx;
+                    if (slot < used && taken[slot] && attacks[slot] != value) { fits = false; break; }
+                }
+                if (!fits) continue;
+
+                for (const auto& [idx, value] : t.entries) {
+                    attacks[offset + idx] = value;
+                    taken[offset + idx] = 1;
+                    used = std::max(used, offset + idx + 1);
+                }
+                return offset;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // FANCY MAGICS
+    // Subtables are the startup-built ones, re-derived through MagicSliders so
+    // all backends agree by construction. Placed largest first.
+    // ------------------------------------------------------------------------
+    void FancySliders::Data::build()
+    {
+        struct Pending { MagicSubTable table; Entry* entry; };
+        std::vector<Pending> pending;
+        pending.reserve(128);
+
+        for (int sq = 0; sq < 64; ++sq) {
+            rookEntries[sq] = { tables.rookMasks[sq], tables.rookMagicNumbers[sq], 0, (uint32_t)tables.rookShifts[sq] };
+            pending.push_back({ collect(tables.rookMasks[sq], tables.rookMagicNumbers[sq], tables.rookShifts[sq],
+                [sq](map occ) { return MagicSliders::rook(sq, occ); }), &rookEntries[sq] });
+
+            bishopEntries[sq] = { tables.bishopMasks[sq], tables.bishopMagicNumbers[sq], 0, (uint32_t)tables.bishopShifts[sq] };
+            pending.push_back({ collect(tables.bishopMasks[sq], tables.bishopMagicNumbers[sq], tables.bishopShifts[sq],
+                [sq](map occ) { return MagicSliders::bishop(sq, occ); }), &bishopEntries[sq] });
+        }
+
+        std::stable_sort(pending.begin(), pending.end(),
+            [](const Pending& a, const Pending& b) { return a.table.size > b.table.size; });
+
+        std::fill(std::begin(attacks), std::end(attacks), 0ULL);
+        std::vector<uint8_t> taken(kMaxAttacks, 0);
+        for (auto& p : pending)
+            p.entry->offset = place(p.table, attacks, taken, used);
+    }
+
+    FancySliders::Data FancySliders::data{};
+
+    void FancySliders::init()
+    {
+        static std::once_flag once;
+        std::call_once(once, [] { data.build(); });
+    }
+
+#ifdef ONEMINDARMY_CHESS_HAS_PEXT
+    // ------------------------------------------------------------------------
+    // PEXT
+    // Dense tables: index = PEXT(occ, mask), so square sq owns 2^popcount(mask)
+    // consecutive slots. PDEP walks the same index space back to occupancies.
+    // ------------------------------------------------------------------------
+    void PextSliders::Data::build()
+    {
+        uint32_t rookOffset = 0, bishopOffset = 0;
+        for (int sq = 0; sq < 64; ++sq) {
+            rookEntries[sq] = { tables.rookMasks[sq], rookOffset };
+            const uint32_t rookCount = 1u << std::popcount(tables.rookMasks[sq]);
+            for (uint32_t i = 0; i < rookCount; ++i)
+                rookAttacks[rookOffset + i] = MagicSliders::rook(sq, _pdep_u64(i, tables.rookMasks[sq]));
+            rookOffset += rookCount;
+
+            bishopEntries[sq] = { tables.bishopMasks[sq], bishopOffset };
+            const uint32_t bishopCount = 1u << std::popcount(tables.bishopMasks[sq]);
+            for (uint32_t i = 0; i < bishopCount; ++i)
+                bishopAttacks[bishopOffset + i] = MagicSliders::bishop(sq, _pdep_u64(i, tables.bishopMasks[sq]));
+            bishopOffset += bishopCount;
+        }
+    }
+
+    PextSliders::Data PextSliders::data{};
+
+    void PextSliders::init()
+    {
+        static std::once_flag once;
+        std::call_once(once, [] { data.build(); });
+    }
+#endif
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include <cstdint>
+
+#include "Tables.hpp"
+#include "../../corelib/util/CompilerHints.hpp"
+
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define ONEMINDARMY_CHESS_HAS_PEXT 1
+#endif
+
+namespace Chess
+{
+    using map = uint64_t;
+
+    // ============================================================================
+    // SLIDER ATTACK BACKENDS
+    // Bishop/rook attack lookups behind one static interface:
+    //   Backend::bishop(sq, occ), Backend::rook(sq, occ)
+    // 'occ' may hold any pieces; each backend masks it itself.
+    //
+    //   MagicSliders : the startup-built magic tables (Tables.hpp, 841 KB).
+    //                  Each lookup reads four per-square arrays (mask, magic,
+    //                  shift, offset).
+    //   PextSliders  : BMI2 PEXT indexing into dense tables (841 KB). No magic
+    //                  multiply, and no magic numbers to load.
+    //   FancySliders : the same magics, with all 128 tables packed into one shared
+    //                  array (overlapping wherever entries agree or are unused) and
+    //                  one 24-byte entry per square. With the current magics every
+    //                  index is reachable, so nothing overlaps yet (841 KB).
+    //
+    // The active backend is chosen at build time (ONEMINDARMY_CHESS_SLIDERS, see
+    // CMakeLists.txt). Every backend available in the build stays usable for
+    // benchmarks (PerftTool::runSliderBench). The magic tables are built at
+    // startup (Tables.cpp); the fancy and PEXT ones are derived from them on
+    // demand by Backend::init(): for the active backend once the CPU check has
+    // passed (ChessEngine::specificSetup), for the others only when the bench
+    // runs. Until then they are untouched zero pages.
+    // ============================================================================
+    struct MagicSliders
+    {
+        static constexpr const char* kName = "magic";
+
+        static void init() noexcept {}
+
+        static ALWAYS_INLINE map bishop(int sq, map occ) noexcept
+        {
+            int idx = (int)(((occ & tables.bishopMasks[sq]) * tables.bishopMagicNumbers[sq]) >> tables.bishopShifts[sq]);
+            return tables.bishopAttacks[tables.bishopOffsets[sq] + idx];
+        }
+
+        static ALWAYS_INLINE map rook(int sq, map occ) noexcept
+        {
+            int idx = (int)(((occ & tables.rookMasks[sq]) * tables.rookMagicNumbers[sq]) >> tables.rookShifts[sq]);
+            return tables.rookAttacks[tables.rookOffsets[sq] + idx];
+        }
+    };
+
+    struct FancySliders
+    {
+        static constexpr const char* kName = "fancy";
+
+        struct Entry
+        {
+            map mask;
+            map magic;
+            uint32_t offset;
+            uint32_t shift;
+        };
+
+        // Upper bound: the tables laid end to end (102400 rook + 5248 bishop).
+        static constexpr uint32_t kMaxAttacks = 107648;
+
+        struct Data
+        {
+            alignas(64) Entry rookEntries[64];
+            alignas(64) Entry bishopEntries[64];
+            alignas(64) map attacks[kMaxAttacks];
+            uint32_t used = 0;   // Packed size actually referenced (<= kMaxAttacks)
+
+            void build();
+        };
+
+        // Zero until init(); no dynamic initialization.
+        static Data data;
+
+        // Builds 'data' on first call (thread-safe); later calls return at once.
+        static void init();
+
+        static ALWAYS_INLINE map lookup(const Entry& e, map occ) noexcept
+        {
+            return data.attacks[e.offset + (uint32_t)(((occ & e.mask) * e.magic) >> e.shift)];
+        }
+
+        static ALWAYS_INLINE map bishop(int sq, map occ) noexcept { return lookup(data.bishopEntries[sq], occ); }
+        static ALWAYS_INLINE map rook(int sq, map occ) noexcept { return lookup(data.rookEntries[sq], occ); }
+    };
+
+#ifdef ONEMINDARMY_CHESS_HAS_PEXT
+    struct PextSliders
+    {
+        static constexpr const char* kName = "pext";
+
+        struct Entry
+        {
+            map mask;
+            uint32_t offset;
+        };
+
+        static constexpr uint32_t kRookAttacks = 102400;
+        static constexpr uint32_t kBishopAttacks = 5248;
+
+        struct Data
+        {
+            alignas(64) Entry rookEntries[64];
+            alignas(64) Entry bishopEntries[64];
+            alignas(64) map rookAttacks[kRookAttacks];
+            alignas(64) map bishopAttacks[kBishopAttacks];
+
+            void build();
+        };
+
+        // Zero until init(). Built with PDEP, so it must never be touched by
+        // static initialization: that would run before the BMI2 check.
+        static Data data;
+
+        static void init();
+
+        static ALWAYS_INLINE map bishop(int sq, map occ) noexcept
+        {
+            const Entry& e = data.bishopEntries[sq];
+            return data.bishopAttacks[e.offset + (uint32_t)_pext_u64(occ, e.mask)];
+        }
+
+        static ALWAYS_INLINE map rook(int sq, map occ) noexcept
+        {
+            const Entry& e = data.rookEntries[sq];
+            return data.rookAttacks[e.offset + (uint32_t)_pext_u64(occ, e.mask)];
+        }
+    };
+#endif
+
+#if defined(ONEMINDARMY_CHESS_SLIDERS_PEXT)
+#ifndef ONEMINDARMY_CHESS_HAS_PEXT
+#error "ONEMINDARMY_CHESS_SLIDERS=PEXT needs a BMI2 target (e.g. -mbmi2 or -march=haswell)"
+#endif
+    using ActiveSliders = PextSliders;
+#elif defined(ONEMINDARMY_CHESS_SLIDERS_FANCY)
+    using ActiveSliders = FancySliders;
+#else
+    using ActiveSliders = MagicSliders;
+#endif
+
+    // Runtime counterpart of the build-time choice. Throws if the CPU cannot run
+    // the active backend (PEXT without BMI2) and warns when it runs it slowly
+    // (microcoded PEXT on AMD before Zen 3). Call before ActiveSliders::init().
+    // Defined in SliderSupport.cpp, which is compiled without BMI2.
+    void checkSliderBackendSupport();
+}
@@ -0,0 +1,62 @@
+// CPU check for the slider attack backend (declared in SliderAttacks.hpp).
+//
+// Deliberately does not include SliderAttacks.hpp: in PEXT builds this file is
+// compiled without BMI2 (see CMakeLists.txt), so it can run on any x86-64 CPU
+// and report a missing BMI2 instead of dying on an illegal instruction.
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(ONEMINDARMY_CHESS_SLIDERS_PEXT)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace Chess
+{
+#if defined(ONEMINDARMY_CHESS_SLIDERS_PEXT)
+    namespace
+    {
+        void cpuid(uint32_t leaf, uint32_t sub, uint32_t out[4])
+        {
+#if defined(_MSC_VER)
+            int regs[4];
+            __cpuidex(regs, (int)leaf, (int)sub);
+            for (int i = 0; i < 4; ++i) out[i] = (uint32_t)regs[i];
+#else
+            if (!__get_cpuid_count(leaf, sub, &out[0], &out[1], &out[2], &out[3]))
+                out[0] = out[1] = out[2] = out[3] = 0;
+#endif
+        }
+    }
+#endif
+
+    void checkSliderBackendSupport()
+    {
+#if defined(ONEMINDARMY_CHESS_SLIDERS_PEXT)
+        uint32_t r[4];
+        cpuid(0, 0, r);
+        const uint32_t maxLeaf = r[0];
+        const bool isAmd = (r[1] == 0x68747541 && r[3] == 0x69746E65 && r[2] == 0x444D4163); // "AuthenticAMD"
+
+        bool bmi2 = false;
+        if (maxLeaf >= 7) {
+            cpuid(7, 0, r);
+            bmi2 = (r[1] >> 8) & 1;
+        }
+        if (!bmi2)
+            throw std::runtime_error("[ChessEngine] Slider backend 'pext' needs BMI2, which this CPU lacks. "
+                "Rebuild with -DONEMINDARMY_CHESS_SLIDERS=FANCY (or MAGIC).");
+
+        cpuid(1, 0, r);
+        const uint32_t baseFamily = (r[0] >> 8) & 0xF;
+        const uint32_t family = (baseFamily == 0xF) ? baseFamily + ((r[0] >> 20) & 0xFF) : baseFamily;
+        if (isAmd && family < 0x19)
+            std::cout << "[ChessEngine] Warning: PEXT is microcoded on this AMD CPU (pre-Zen 3); "
+                "the 'fancy' slider backend is likely faster.\n";
+#endif
+    }
+}
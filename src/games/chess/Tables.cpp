@@ -0,0 +1,206 @@
+#include "Tables.hpp"
+
+#include <bit>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace Chess
+{
+	namespace
+	{
+		// (file, rank) steps.
+		constexpr int kBishopDirs[4][2] = { { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } };
+		constexpr int kRookDirs[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+		constexpr int kKnightSteps[8][2] = { { 1, 2 }, { 2, 1 }, { 2, -1 }, { 1, -2 }, { -1, -2 }, { -2, -1 }, { -2, 1 }, { -1, 2 } };
+		constexpr int kKingSteps[8][2] = { { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 } };
+
+		constexpr bool onBoard(int file, int rank) noexcept { return file >= 0 && file < 8 && rank >= 0 && rank < 8; }
+		constexpr uint64_t bitAt(int file, int rank) noexcept { return 1ULL << (rank * 8 + file); }
+
+		uint64_t slide(int sq, uint64_t occ, const int (&dirs)[4][2]) noexcept
+		{
+			uint64_t atk = 0;
+			for (const auto& d : dirs) {
+				for (int f = sq % 8 + d[0], r = sq / 8 + d[1]; onBoard(f, r); f += d[0], r += d[1]) {
+					atk |= bitAt(f, r);
+					if (occ & bitAt(f, r)) break;
+				}
+			}
+			return atk;
+		}
+
+		// Relevant occupancy: the empty-board rays minus their last square, whose
+		// occupant can never cut the ray short.
+		uint64_t relevantMask(int sq, const int (&dirs)[4][2]) noexcept
+		{
+			uint64_t mask = 0;
+			for (const auto& d : dirs) {
+				for (int f = sq % 8 + d[0], r = sq / 8 + d[1]; onBoard(f + d[0], r + d[1]); f += d[0], r += d[1])
+					mask |= bitAt(f, r);
+			}
+			return mask;
+		}
+
+		uint64_t leaperMask(int sq, const int (&steps)[8][2]) noexcept
+		{
+			uint64_t mask = 0;
+			for (const auto& s : steps) {
+				const int f = sq % 8 + s[0], r = sq / 8 + s[1];
+				if (onBoard(f, r)) mask |= bitAt(f, r);
+			}
+			return mask;
+		}
+
+		// Generator seed per square, chosen offline so that the search below
+		// accepts one of its first few candidates (most often the very first):
+		// the whole search then takes well under a millisecond. Any seed would
+		// work, just slower (tens of thousands of candidates on some rook squares).
+		constexpr uint16_t kRookSeeds[64] = {
+			13359,  1897, 28245, 16388, 11763, 21674, 19475, 20957,
+			10028,  5402, 12825, 20466,  5083, 20451,  5553,  8431,
+			 9426,   484, 11340,  4198, 54482, 36964,  4809,  8480,
+			 6108,  3475, 11024,  2422, 21849, 37659,  1087, 24523,
+			 4878,  1145,  6228, 10884, 11280, 22338, 10237,  8974,
+			 3842,  6869,   349, 12819, 27838, 17075,  2555,   188,
+			 1226,  1226,  5531,  1866,  9533, 37133,  1714, 12115,
+			20711,  2902,  3305, 11383, 46380,  6229, 10121,  2196,
+		};
+		constexpr uint16_t kBishopSeeds[64] = {
+			   68,    53,   337,    55,    61,    47,    92,   336,
+			  230,    79,   166,   214,   112,   333,   190,    30,
+			   45,     5,  1474,   116,  2066,   342,   236,    67,
+			   25,   244,   237,  1646,  2619,   350,    46,    99,
+			  239,    29,   195,    16,   473,   240,   122,    83,
+			  100,   184,    32,   631,  1527,    87,    87,   185,
+			   92,    92,    13,   128,    57,    31,    61,    53,
+			  336,    30,   191,    89,    32,    53,   230,    68,
+		};
+
+		// xorshift64*: tiny and deterministic, so every run finds the same magics.
+		struct MagicRng
+		{
+			uint64_t s;
+
+			uint64_t next() noexcept
+			{
+				s ^= s >> 12;
+				s ^= s << 25;
+				s ^= s >> 27;
+				return s * 2685821657736338717ULL;
+			}
+
+			// Few set bits make good magic candidates.
+			uint64_t sparse() noexcept { return next() & next() & next(); }
+		};
+
+		// Finds a magic for one square and fills its slots of 'attacks'. Every
+		// relevant occupancy must land on a slot holding its own attack set
+		// (constructive collisions allowed). 'epoch' marks the slots written by
+		// the current candidate, which saves clearing the table between tries.
+		uint64_t findMagic(int sq, uint64_t mask, int shift, const int (&dirs)[4][2],
+			uint64_t* attacks, MagicRng& rng, std::vector<uint32_t>& epoch)
+		{
+			std::vector<uint64_t> occs, refs;
+			uint64_t occ = 0;
+			do {
+				occs.push_back(occ);
+				refs.push_back(slide(sq, occ, dirs));
+				occ = (occ - mask) & mask;
+			} while (occ);
+
+			const uint32_t size = 1u << (64 - shift);
+			epoch.assign(size, 0);
+
+			for (uint32_t attempt = 1;; ++attempt) {
+				uint64_t magic;
+				do { magic = rng.sparse(); } while (std::popcount((mask * magic) >> 56) < 6);
+
+				size_t i = 0;
+				for (; i < occs.size(); ++i) {
+					const uint32_t idx = static_cast<uint32_t>((occs[i] * magic) >> shift);
+					if (epoch[idx] < attempt) {
+						epoch[idx] = attempt;
+						attacks[idx] = refs[i];
+					}
+					else if (attacks[idx] != refs[i]) break;
+				}
+				if (i == occs.size()) {
+					// Slots no occupancy reaches keep a defined value.
+					for (uint32_t s = 0; s < size; ++s) if (epoch[s] != attempt) attacks[s] = 0;
+					return magic;
+				}
+			}
+		}
+	}
+
+	uint64_t slidingBishopAttacks(int sq, uint64_t occ) noexcept { return slide(sq, occ, kBishopDirs); }
+	uint64_t slidingRookAttacks(int sq, uint64_t occ) noexcept { return slide(sq, occ, kRookDirs); }
+
+	void adviseHugePages(const void* p, size_t bytes) noexcept
+	{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		constexpr uintptr_t kPage = 4096;
+		const uintptr_t begin = reinterpret_cast<uintptr_t>(p) & ~(kPage - 1);
+		const uintptr_t end = (reinterpret_cast<uintptr_t>(p) + bytes + kPage - 1) & ~(kPage - 1);
+		madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+#else
+		(void)p;
+		(void)bytes;
+#endif
+	}
+
+	Tables::Tables()
+	{
+		adviseHugePages(this, sizeof(*this));
+
+		for (int sq = 0; sq < 64; ++sq) {
+			knightMasks[sq] = leaperMask(sq, kKnightSteps);
+			kingMasks[sq] = leaperMask(sq, kKingSteps);
+		}
+
+		for (int from = 0; from < 64; ++from) {
+			for (int to = 0; to < 64; ++to) {
+				uint64_t ray = 0;
+				if (from != to) {
+					const int df = to % 8 - from % 8, dr = to / 8 - from / 8;
+					if (df == 0 || dr == 0 || std::abs(df) == std::abs(dr)) {
+						const int sf = (df > 0) - (df < 0), sr = (dr > 0) - (dr < 0);
+						int f = from % 8, r = from / 8;
+						do {
+							f += sf; r += sr;
+							ray |= bitAt(f, r);
+						} while (f + r * 8 != to);
+					}
+				}
+				rayBetween[from * 64 + to] = ray;
+			}
+		}
+		// Unpinned pieces read entry 0 (see MoveGenerator::getPinRay).
+		rayBetween[0] = ~0ULL;
+
+		std::vector<uint32_t> epoch;
+
+		int rookOffset = 0, bishopOffset = 0;
+		for (int sq = 0; sq < 64; ++sq) {
+			rookMasks[sq] = relevantMask(sq, kRookDirs);
+			rookShifts[sq] = 64 - std::popcount(rookMasks[sq]);
+			rookOffsets[sq] = rookOffset;
+			MagicRng rng{ kRookSeeds[sq] };
+			rookMagicNumbers[sq] = findMagic(sq, rookMasks[sq], rookShifts[sq], kRookDirs, rookAttacks + rookOffset, rng, epoch);
+			rookOffset += 1 << (64 - rookShifts[sq]);
+
+			bishopMasks[sq] = relevantMask(sq, kBishopDirs);
+			bishopShifts[sq] = 64 - std::popcount(bishopMasks[sq]);
+			bishopOffsets[sq] = bishopOffset;
+			rng = MagicRng{ kBishopSeeds[sq] };
+			bishopMagicNumbers[sq] = findMagic(sq, bishopMasks[sq], bishopShifts[sq], kBishopDirs, bishopAttacks + bishopOffset, rng, epoch);
+			bishopOffset += 1 << (64 - bishopShifts[sq]);
+		}
+	}
+
+	const Tables tables{};
+}
@@ -1,73 +1,72 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
+// Tables are placed on their own 2 MB boundary where transparent huge pages
+// exist, so the whole set can sit in a single TLB entry.
+#if defined(__linux__)
+#define CHESS_TABLES_ALIGN (2 * 1024 * 1024)
+#else
+#define CHESS_TABLES_ALIGN 64
+#endif
+
 namespace Chess
 {
-	struct Tables
+	// ============================================================================
+	// ATTACK TABLES
+	// Leaper masks, king-to-square rays and plain per-square magic slider
+	// attacks: every square owns its own slice of the rook or bishop array, in
+	// split mask/magic/shift/offset arrays. The fancy-magic packing (one shared
+	// array, one entry per square) is FancySliders, in SliderAttacks.hpp.
+	//
+	// Design Intent:
+	// Built once at startup (Tables.cpp: masks and rays by ray walking, magics
+	// by a seeded sparse-random search) instead of being compiled in from
+	// generated literal files. The object lives in static storage, so accesses
+	// keep a link-time address; only its contents are computed.
+	//
+	// Magic layout: square sq owns 2^(64 - shift) consecutive slots starting at
+	// offset[sq], indexed by ((occ & mask) * magic) >> shift.
+	// ============================================================================
+	struct alignas(CHESS_TABLES_ALIGN) Tables
 	{
-		static constexpr uint64_t knightMasks[64] =
-		{
-			#include "generated/knightMasks.inc"
-		};
-
-		static constexpr uint64_t bishopMasks[64] =
-		{
-			#include "generated/bishopMasks.inc"
-		};
-
-		static constexpr int bishopShifts[64] =
-		{
-			#include "generated/bishopShifts.inc"
-		};
+		static constexpr uint32_t kRookAttacks = 102400;
+		static constexpr uint32_t kBishopAttacks = 5248;
 
-		static constexpr uint64_t bishopMagicNumbers[64] =
-		{
-			#include "generated/bishopMagicNumbers.inc"
-		};
+		uint64_t knightMasks[64];
+		uint64_t kingMasks[64];
 
-		static constexpr uint64_t bishopAttacks[64 * 512] =
-		{
-			#include "generated/bishopAttacks.inc"
-		};
+		uint64_t bishopMasks[64];
+		uint64_t bishopMagicNumbers[64];
+		int bishopShifts[64];
+		int bishopOffsets[64];
 
-		static constexpr int bishopOffsets[64] =
-		{
-			#include "generated/bishopOffsets.inc"
-		};
+		uint64_t rookMasks[64];
+		uint64_t rookMagicNumbers[64];
+		int rookShifts[64];
+		int rookOffsets[64];
 
-		static constexpr uint64_t rookMasks[64] =
-		{
-			#include "generated/rookMasks.inc"
-		};
+		// Squares strictly between 'from' and 'to', plus 'to' itself, when both
+		// share a rank, file or diagonal; 0 otherwise. Indexed [from * 64 + to].
+		// Entry 0 holds all squares instead: the ray of an unpinned piece.
+		alignas(64) uint64_t rayBetween[64 * 64];
 
-		static constexpr int rookShifts[64] =
-		{
-			#include "generated/rookShifts.inc"
-		};
+		alignas(64) uint64_t bishopAttacks[kBishopAttacks];
+		alignas(64) uint64_t rookAttacks[kRookAttacks];
 
-		static constexpr uint64_t rookMagicNumbers[64] =
-		{
-			#include "generated/rookMagicNumbers.inc"
-		};
-
-		static constexpr uint64_t rookAttacks[64 * 4096] =
-		{
-			#include "generated/rookAttacks.inc"
-		};
+		Tables();
+	};
 
-		static constexpr int rookOffsets[64] =
-		{
-			#include "generated/rookOffsets.inc"
-		};
+	// Defined in Tables.cpp. Built during static initialization, so that file is
+	// compiled without BMI2 in PEXT builds (it runs before the CPU check).
+	extern const Tables tables;
 
-		static constexpr uint64_t kingMasks[64] =
-		{
-			#include "generated/kingMasks.inc"
-		};
+	// Asks the OS to back [p, p + bytes) with huge pages. Best effort: a no-op
+	// where unsupported. Call before the memory is first written.
+	void adviseHugePages(const void* p, size_t bytes) noexcept;
 
-		static constexpr uint64_t rayBetween[64 * 64] =
-		{
-			#include "generated/rayBetween.inc"
-		};
-	};
-}
\ No newline at end of file
+	// Reference attacks of a bishop / rook on 'sq', by walking each ray until
+	// the first occupied square (included).
+	uint64_t slidingBishopAttacks(int sq, uint64_t occ) noexcept;
+	uint64_t slidingRookAttacks(int sq, uint64_t occ) noexcept;
+}
@@ -42,6 +42,16 @@ namespace Chess
             { "Other 1", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292 },
             { "Other 1", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 6, 706045033 }
         };
+
+        // Slider backend benchmark (go perft sliderBench): about two seconds per backend.
+        m_benchTests =
+        {
+            { "Good Test", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 5, 193690690 },
+            { "Most Legal Moves", "R6R/3Q4/1Q4Q1/4Q3/2Q4Q/Q4Q2/pp1Q4/kBNN1KB1 w - - 0 1", 5, 13853661 },
+            { "Other 1", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292 },
+            { "Start", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609 },
+            { "Discover Promo", "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1", 5, 3605103 }
+        };
     }
 
     void UCIHandler::specificSetup(const YAML::Node& config)
@@ -128,6 +138,10 @@ namespace Chess
             {
                 m_perftTool.runDivide(m_perftTests);
             }
+            else if (m_parsedLine[2] == "sliderBench")
+            {
+                m_perftTool.runSliderBench(m_benchTests);
+            }
             else
             {
                 cmdInvalid();
@@ -9,6 +9,7 @@ namespace Chess
 	private:
 		PerftTool m_perftTool;
 		Vec<PerftTest> m_perftTests;
+		Vec<PerftTest> m_benchTests;
 		Vec<std::string> m_parsedLine;
 
 		static constexpr const char* kStartpos = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";